@@ -0,0 +1,259 @@
+#ifndef ALIMENTACAO_PESOS_H
+#define ALIMENTACAO_PESOS_H
+
+// Atualizações de peso ao vivo lidas de um pipe nomeado (FIFO) ou de um socket Unix.
+// Uma thread lê registros de texto, um por linha:
+//     <origem> <destino> <peso>        (peso 0 remove a aresta)
+// (inteiros sem sinal de até 32 bits; qualquer outra coisa na linha a invalida)
+// e os agrupa por aresta (vale o último peso recebido); a thread principal retira o
+// lote acumulado uma vez por quadro com drain(); enquanto ela não retira (durante a
+// animação), o lote guarda no máximo MAX_PENDING arestas distintas. Se o caminho já é
+// um FIFO, ele é aberto para leitura; caso contrário é criado um socket Unix que aceita
+// vários clientes. O atraso (recebimento -> aplicação) de cada lote é registrado.
+
+#include <vector>
+#include <string>
+#include <mutex>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <cerrno>
+#include <cstdio>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <algorithm>
+#include <unordered_map>
+#include <iostream>
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+
+struct WeightUpdate {
+    uint32_t from, to;
+    uint32_t weight;
+    double receivedAt; // WeightFeed::clock() do registro mais antigo ainda não aplicado
+};
+
+class WeightFeed {
+public:
+    ~WeightFeed() { stop(); }
+
+    static double clock() {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    bool start(const std::string& path) {
+        struct stat info;
+        if (stat(path.c_str(), &info) == 0 && S_ISFIFO(info.st_mode)) {
+            // O_RDWR: o próprio leitor conta como escritor, então o FIFO não chega ao
+            // fim quando um produtor fecha, e o próximo pode continuar escrevendo
+            int fd = open(path.c_str(), O_RDWR | O_NONBLOCK);
+            if (fd < 0) {
+                std::cerr << "Erro: não foi possível abrir o FIFO " << path << std::endl;
+                return false;
+            }
+            sources.push_back({ fd, std::string() });
+        } else {
+            sockaddr_un address;
+            memset(&address, 0, sizeof(address));
+            address.sun_family = AF_UNIX;
+            if (path.size() >= sizeof(address.sun_path)) {
+                std::cerr << "Erro: caminho de socket longo demais: " << path << std::endl;
+                return false;
+            }
+            strcpy(address.sun_path, path.c_str());
+            unlink(path.c_str()); // socket deixado por uma execução anterior
+            listener = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK, 0);
+            if (listener < 0 || bind(listener, (sockaddr*)&address, sizeof(address)) != 0 || listen(listener, 8) != 0) {
+                std::cerr << "Erro: não foi possível criar o socket " << path << std::endl;
+                if (listener >= 0) close(listener);
+                listener = -1;
+                return false;
+            }
+            socketPath = path;
+        }
+        startTime = clock();
+        running = true;
+        reader = std::thread(&WeightFeed::readLoop, this);
+        return true;
+    }
+
+    void stop() {
+        if (!running) return;
+        running = false;
+        reader.join();
+        for (const Source& s : sources) close(s.fd);
+        sources.clear();
+        if (listener >= 0) {
+            close(listener);
+            unlink(socketPath.c_str());
+            listener = -1;
+        }
+    }
+
+    bool active() const { return running; }
+
+    // Troca o lote acumulado por out (esvaziado antes); chamado uma vez por quadro
+    void drain(std::vector<WeightUpdate>& out) {
+        out.clear();
+        std::lock_guard<std::mutex> lock(mutex);
+        out.swap(pending);
+        pendingIndex.clear();
+    }
+
+    // Registra um lote aplicado: quantos registros, quantos recusados e o maior atraso
+    void noteBatch(size_t applied, size_t rejected, double lagMs) {
+        appliedCount += applied;
+        rejectedCount += rejected;
+        lastLagMs = lagMs;
+        batchLags.push_back(lagMs);
+    }
+
+    double lastLag() const { return lastLagMs; }
+
+    void printSummary() const {
+        double seconds = std::max(clock() - startTime, 1e-9);
+        uint64_t received = receivedCount.load();
+        printf("pesos: %llu registros (%.0f/s), %llu agrupados, %llu aplicados, %llu recusados, %llu linhas inválidas, "
+               "%llu descartados (lote cheio)\n",
+               (unsigned long long)received, received / seconds, (unsigned long long)coalescedCount.load(),
+               (unsigned long long)appliedCount, (unsigned long long)rejectedCount,
+               (unsigned long long)invalidCount.load(), (unsigned long long)overflowCount.load());
+        if (batchLags.empty()) return;
+        std::vector<double> lags(batchLags);
+        std::sort(lags.begin(), lags.end());
+        auto percentile = [&lags](double p) { return lags[std::min(lags.size() - 1, (size_t)(p * lags.size()))]; };
+        printf("atraso por lote (ms): p50 %.3f  p95 %.3f  p99 %.3f  max %.3f  (%zu lotes)\n", percentile(0.50),
+               percentile(0.95), percentile(0.99), lags.back(), lags.size());
+    }
+
+private:
+    struct Source {
+        int fd;
+        std::string partial;     // linha incompleta do último read()
+        bool discarding = false; // linha longa demais: ignora até o próximo '\n'
+    };
+
+    static constexpr size_t MAX_LINE = 256;        // uma atualização válida cabe com folga
+    static constexpr size_t MAX_PENDING = 1 << 16; // arestas distintas esperando drain()
+
+    // Um inteiro sem sinal de até 32 bits depois de espaços; avança c. Sinal, estouro
+    // e campo vazio falham (strtoul aceitaria "-1" dando a volta).
+    static bool parseField(const char*& c, uint32_t& out) {
+        while (*c == ' ' || *c == '\t') ++c;
+        if (*c < '0' || *c > '9') return false;
+        char* end;
+        errno = 0;
+        unsigned long long value = strtoull(c, &end, 10);
+        if (errno == ERANGE || value > UINT32_MAX) return false;
+        out = (uint32_t)value;
+        c = end;
+        return true;
+    }
+
+    void readLoop() {
+        std::vector<pollfd> fds;
+        char buffer[1 << 16];
+        while (running) {
+            fds.clear();
+            if (listener >= 0) fds.push_back({ listener, POLLIN, 0 });
+            for (const Source& s : sources) fds.push_back({ s.fd, POLLIN, 0 });
+            if (poll(fds.data(), fds.size(), 100) <= 0) continue; // acorda para ver running
+
+            size_t first = 0;
+            if (listener >= 0) {
+                first = 1;
+                if (fds[0].revents & POLLIN) {
+                    int client;
+                    while ((client = accept4(listener, nullptr, nullptr, SOCK_NONBLOCK)) >= 0)
+                        sources.push_back({ client, std::string() });
+                }
+            }
+            for (size_t i = first; i < fds.size(); ++i) {
+                if (!fds[i].revents) continue;
+                Source& s = sources[i - first];
+                ssize_t n;
+                while ((n = read(s.fd, buffer, sizeof(buffer))) > 0) parse(s, buffer, (size_t)n);
+                if (n == 0 || (n < 0 && errno != EAGAIN && errno != EWOULDBLOCK)) {
+                    close(s.fd); // cliente do socket desconectou
+                    s.fd = -1;
+                }
+            }
+            sources.erase(std::remove_if(sources.begin(), sources.end(), [](const Source& s) { return s.fd < 0; }),
+                          sources.end());
+        }
+    }
+
+    // Separa as linhas completas e as agrupa no lote pendente com um único lock
+    void parse(Source& s, const char* data, size_t size) {
+        if (s.discarding) {
+            const char* newline = (const char*)memchr(data, '\n', size);
+            if (!newline) return;
+            s.discarding = false;
+            size -= (size_t)(newline + 1 - data);
+            data = newline + 1;
+        }
+        s.partial.append(data, size);
+        double now = clock();
+        size_t begin = 0, end;
+        parsed.clear();
+        while ((end = s.partial.find('\n', begin)) != std::string::npos) {
+            s.partial[end] = '\0';
+            const char* c = s.partial.c_str() + begin;
+            uint32_t from, to, weight;
+            bool ok = parseField(c, from) && parseField(c, to) && parseField(c, weight);
+            while (ok && (*c == ' ' || *c == '\t' || *c == '\r')) ++c;
+            if (ok && *c == '\0') parsed.push_back({ from, to, weight, now });
+            else if (end > begin) ++invalidCount;
+            begin = end + 1;
+        }
+        s.partial.erase(0, begin);
+        // Produtor que nunca manda '\n' não pode fazer o buffer crescer sem limite
+        if (s.partial.size() > MAX_LINE) {
+            ++invalidCount;
+            s.partial.clear();
+            s.discarding = true;
+        }
+        if (parsed.empty()) return;
+
+        receivedCount += parsed.size();
+        std::lock_guard<std::mutex> lock(mutex);
+        for (const WeightUpdate& u : parsed) {
+            uint64_t key = (uint64_t)u.from << 32 | u.to;
+            auto it = pendingIndex.find(key);
+            if (it == pendingIndex.end()) {
+                if (pending.size() >= MAX_PENDING) {
+                    ++overflowCount;
+                    continue;
+                }
+                pendingIndex.emplace(key, pending.size());
+                pending.push_back(u);
+            } else {
+                pending[it->second].weight = u.weight; // mantém o recebimento mais antigo
+                ++coalescedCount;
+            }
+        }
+    }
+
+    std::atomic<bool> running{ false };
+    std::thread reader;
+    int listener = -1;
+    std::string socketPath;
+    std::vector<Source> sources; // só a thread de leitura mexe depois de start()
+    std::vector<WeightUpdate> parsed;
+
+    std::mutex mutex; // protege pending e pendingIndex
+    std::vector<WeightUpdate> pending;
+    std::unordered_map<uint64_t, size_t> pendingIndex;
+
+    std::atomic<uint64_t> receivedCount{ 0 }, coalescedCount{ 0 }, invalidCount{ 0 }, overflowCount{ 0 };
+    uint64_t appliedCount = 0, rejectedCount = 0; // thread principal
+    double lastLagMs = 0.0, startTime = 0.0;
+    std::vector<double> batchLags;
+};
+
+#endif
@@ -0,0 +1,202 @@
+#ifndef ARQUIVO_GRAFO_H
+#define ARQUIVO_GRAFO_H
+
+// Leitura e escrita de grafos em dois formatos:
+//  - texto (carregável pelo trabalho.cpp e editável à mão):
+//        # comentários começam com #
+//        n m
+//        x y                (n linhas, posição de cada vértice)
+//        origem destino peso (m linhas)
+//  - snapshot binário: o CSR e as posições gravados como estão na memória, para
+//    abrir grafos de 10^8 arestas sem reconverter texto. Cabeçalho fixo com o
+//    tamanho dos tipos; o arquivo usa a ordem de bytes da máquina que o gravou.
+
+#include <vector>
+#include <string>
+#include <cmath>
+#include <limits>
+#include <cstdio>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include "caminhoMinimo.h"
+
+struct Coordinate {
+    float x, y;
+};
+
+static const char SNAPSHOT_MAGIC[8] = { 'G', 'R', 'A', 'F', 'O', 'S', 'N', '1' };
+
+struct SnapshotHeader {
+    char magic[8];
+    uint32_t weightBytes;
+    uint32_t indexBytes;
+    uint64_t numVertices;
+    uint64_t numEdges;
+    uint64_t hasPositions;
+};
+
+// Grava no formato texto; devolve false (com mensagem em cerr) se falhar
+template <typename W, typename Index>
+bool saveGraphText(const std::string& fileName, const Graph<W, Index>& graph, const std::vector<Coordinate>& positions) {
+    FILE* file = fopen(fileName.c_str(), "w");
+    if (!file) {
+        std::cerr << "Erro: não foi possível criar " << fileName << std::endl;
+        return false;
+    }
+    Index n = graph.numVertices();
+    fprintf(file, "%llu %llu\n", (unsigned long long)n, (unsigned long long)graph.numEdges());
+    for (Index v = 0; v < n; ++v) {
+        Coordinate p = v < positions.size() ? positions[v] : Coordinate{ 0.0f, 0.0f };
+        fprintf(file, "%.6f %.6f\n", p.x, p.y);
+    }
+    for (Index v = 0; v < n; ++v)
+        for (size_t e = graph.offsets[v]; e < graph.offsets[(size_t)v + 1]; ++e)
+            fprintf(file, "%llu %llu %.17g\n", (unsigned long long)v, (unsigned long long)graph.targets[e],
+                    (double)graph.weights[e]);
+    bool ok = !ferror(file);
+    fclose(file);
+    if (!ok) std::cerr << "Erro: falha ao gravar " << fileName << std::endl;
+    return ok;
+}
+
+// Peso lido do texto que cabe em W e não é o infinito (NaN, ±inf e negativos em W sem
+// sinal ficam de fora)
+template <typename W>
+bool validWeight(double weight) {
+    return std::isfinite(weight) && weight >= (double)std::numeric_limits<W>::lowest() &&
+           weight <= (double)std::numeric_limits<W>::max() && weight < (double)WeightTraits<W>::infinity();
+}
+
+// Lê o formato texto; posições ausentes no arquivo ficam zeradas
+template <typename W, typename Index>
+bool loadGraphText(const std::string& fileName, Graph<W, Index>& graph, std::vector<Coordinate>& positions) {
+    FILE* file = fopen(fileName.c_str(), "r");
+    if (!file) {
+        std::cerr << "Erro: não foi possível abrir " << fileName << std::endl;
+        return false;
+    }
+
+    // Próxima linha que não é comentário nem vazia; lineNumber conta todas
+    char line[256];
+    unsigned long long lineNumber = 0;
+    bool atEnd = false;
+    auto nextLine = [&]() {
+        while (fgets(line, sizeof(line), file)) {
+            ++lineNumber;
+            const char* c = line;
+            while (*c == ' ' || *c == '\t') ++c;
+            if (*c != '#' && *c != '\n' && *c != '\r' && *c != '\0') return true;
+        }
+        atEnd = true;
+        return false;
+    };
+
+    unsigned long long n = 0, m = 0;
+    bool ok = nextLine() && sscanf(line, "%llu %llu", &n, &m) == 2 && n < (unsigned long long)noVertex<Index>();
+    positions.assign(ok ? n : 0, Coordinate{ 0.0f, 0.0f });
+    for (unsigned long long v = 0; ok && v < n; ++v)
+        ok = nextLine() && sscanf(line, "%f %f", &positions[v].x, &positions[v].y) == 2;
+
+    std::vector<Edge<W, Index>> edges;
+    if (ok) edges.reserve(m);
+    for (unsigned long long e = 0; ok && e < m; ++e) {
+        unsigned long long from, to;
+        double weight;
+        ok = nextLine() && sscanf(line, "%llu %llu %lf", &from, &to, &weight) == 3 && from < n && to < n &&
+             validWeight<W>(weight);
+        if (ok) edges.push_back({ (Index)from, (Index)to, (W)weight });
+    }
+    fclose(file);
+    if (!ok) {
+        if (atEnd) std::cerr << "Erro: " << fileName << " termina antes do esperado" << std::endl;
+        else std::cerr << "Erro: formato inválido em " << fileName << ", linha " << lineNumber << std::endl;
+        return false;
+    }
+    graph = Graph<W, Index>::fromEdges((Index)n, edges);
+    return true;
+}
+
+template <typename W, typename Index>
+bool saveSnapshot(const std::string& fileName, const Graph<W, Index>& graph, const std::vector<Coordinate>& positions) {
+    FILE* file = fopen(fileName.c_str(), "wb");
+    if (!file) {
+        std::cerr << "Erro: não foi possível criar " << fileName << std::endl;
+        return false;
+    }
+    SnapshotHeader header;
+    memcpy(header.magic, SNAPSHOT_MAGIC, sizeof(header.magic));
+    header.weightBytes = sizeof(W);
+    header.indexBytes = sizeof(Index);
+    header.numVertices = graph.numVertices();
+    header.numEdges = graph.numEdges();
+    header.hasPositions = positions.size() == header.numVertices;
+
+    std::vector<uint64_t> offsets(graph.offsets.begin(), graph.offsets.end());
+    bool ok = fwrite(&header, sizeof(header), 1, file) == 1 &&
+              fwrite(offsets.data(), sizeof(uint64_t), offsets.size(), file) == offsets.size() &&
+              fwrite(graph.targets.data(), sizeof(Index), graph.numEdges(), file) == graph.numEdges() &&
+              fwrite(graph.weights.data(), sizeof(W), graph.numEdges(), file) == graph.numEdges();
+    if (ok && header.hasPositions)
+        ok = fwrite(positions.data(), sizeof(Coordinate), positions.size(), file) == positions.size();
+    ok = fclose(file) == 0 && ok;
+    if (!ok) std::cerr << "Erro: falha ao gravar " << fileName << std::endl;
+    return ok;
+}
+
+template <typename W, typename Index>
+bool loadSnapshot(const std::string& fileName, Graph<W, Index>& graph, std::vector<Coordinate>& positions) {
+    FILE* file = fopen(fileName.c_str(), "rb");
+    if (!file) {
+        std::cerr << "Erro: não foi possível abrir " << fileName << std::endl;
+        return false;
+    }
+    SnapshotHeader header;
+    if (fread(&header, sizeof(header), 1, file) != 1 || memcmp(header.magic, SNAPSHOT_MAGIC, sizeof(header.magic)) != 0) {
+        std::cerr << "Erro: " << fileName << " não é um snapshot de grafo" << std::endl;
+        fclose(file);
+        return false;
+    }
+    if (header.weightBytes != sizeof(W) || header.indexBytes != sizeof(Index) ||
+        header.numVertices >= (uint64_t)noVertex<Index>()) {
+        std::cerr << "Erro: snapshot " << fileName << " gravado com outros tipos de peso/índice" << std::endl;
+        fclose(file);
+        return false;
+    }
+
+    std::vector<uint64_t> offsets(header.numVertices + 1);
+    graph.targets.resize(header.numEdges);
+    graph.weights.resize(header.numEdges);
+    bool ok = fread(offsets.data(), sizeof(uint64_t), offsets.size(), file) == offsets.size() &&
+              fread(graph.targets.data(), sizeof(Index), header.numEdges, file) == header.numEdges &&
+              fread(graph.weights.data(), sizeof(W), header.numEdges, file) == header.numEdges;
+    positions.clear();
+    if (ok && header.hasPositions) {
+        positions.resize(header.numVertices);
+        ok = fread(positions.data(), sizeof(Coordinate), positions.size(), file) == positions.size();
+    }
+    fclose(file);
+    ok = ok && offsets.front() == 0 && offsets.back() == header.numEdges;
+    for (size_t v = 0; ok && v < header.numVertices; ++v) ok = offsets[v] <= offsets[v + 1];
+    for (size_t e = 0; ok && e < header.numEdges; ++e) ok = graph.targets[e] < header.numVertices;
+    if (!ok) {
+        std::cerr << "Erro: snapshot " << fileName << " truncado ou corrompido" << std::endl;
+        graph = Graph<W, Index>();
+        return false;
+    }
+    graph.offsets.assign(offsets.begin(), offsets.end());
+    return true;
+}
+
+// Escolhe o formato pela extensão (.snap = snapshot, qualquer outra = texto)
+inline bool isSnapshotFile(const std::string& fileName) {
+    return fileName.size() >= 5 && fileName.compare(fileName.size() - 5, 5, ".snap") == 0;
+}
+
+template <typename W, typename Index>
+bool loadGraph(const std::string& fileName, Graph<W, Index>& graph, std::vector<Coordinate>& positions) {
+    return isSnapshotFile(fileName) ? loadSnapshot(fileName, graph, positions)
+                                    : loadGraphText(fileName, graph, positions);
+}
+
+#endif
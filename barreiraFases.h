@@ -0,0 +1,34 @@
+#ifndef BARREIRA_FASES_H
+#define BARREIRA_FASES_H
+
+// Barreira reutilizável para threads criadas uma vez e sincronizadas entre fases
+// (rodadas do FloydWarshall, níveis do BfsEngine). Com uma thread não faz nada.
+
+#include <mutex>
+#include <condition_variable>
+
+class PhaseBarrier {
+public:
+    explicit PhaseBarrier(unsigned count) : count(count) {}
+
+    // A geração impede que uma thread adiantada passe pela mesma espera duas vezes
+    void wait() {
+        if (count == 1) return;
+        std::unique_lock<std::mutex> lock(mutex);
+        unsigned generation = this->generation;
+        if (++arrived == count) {
+            arrived = 0;
+            ++this->generation;
+            cv.notify_all();
+        } else {
+            cv.wait(lock, [&] { return generation != this->generation; });
+        }
+    }
+
+private:
+    std::mutex mutex;
+    std::condition_variable cv;
+    unsigned count, arrived = 0, generation = 0;
+};
+
+#endif
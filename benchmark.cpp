@@ -0,0 +1,736 @@
+// Benchmark do motor de caminhos mínimos com diferentes numerações de vértices.
+// Gera um grafo geométrico aleatório com ids embaralhados (como uma entrada sem
+// ordem nenhuma) ou lê um arquivo do gerador, renumera por BFS, Cuthill–McKee
+// reverso e curva de Hilbert e mede tempo e faltas de cache (perf_event_open,
+// quando o kernel permite). Por fim mede a hierarquia de níveis de detalhe
+// (nivelDetalhe.h) e quanto a visão afastada desenha.
+// Com --todos-pares compara, numa matriz densa aleatória, o Floyd–Warshall em blocos
+// (floydWarshall.h) com V execuções do Dijkstra denso. Com --lote compara consultas
+// (origem, destino) uma a uma com o BatchRunner (consultasLote.h) em 1 e em todas as threads.
+// Com --tipos roda e confere o motor com pesos uint16, uint32, uint64, float e double.
+// Com --johnson mede a reponderação de Johnson (reponderacaoJohnson.h) num grafo com
+// pesos negativos, confere o Dijkstra, o Yen e o Dijkstra denso sobre os pesos
+// reponderados e compara os todos os pares esparsos com o Floyd–Warshall.
+// O benchmark principal também compara memória e tempo do CSR com o grafo comprimido
+// (grafoCompacto.h); compile com -march=native (ou -mssse3) para a decodificação SIMD.
+//
+// uso: ./benchmark [vértices | arquivo.snap | arquivo.txt] [consultas] [semente]
+//      ./benchmark --todos-pares [vértices] [densidade %] [semente]
+//      ./benchmark --lote [vértices] [consultas] [origens distintas] [semente]
+//      ./benchmark --tipos [vértices] [origens] [semente]
+//      ./benchmark --johnson [vértices] [vértices nos todos os pares] [semente]
+
+#include <iostream>
+#include <string>
+#include <iomanip>
+#include <vector>
+#include <cmath>
+#include <chrono>
+#include <random>
+#include <cstring>
+#include <cstdlib>
+#include <algorithm>
+#include <thread>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+#include "caminhoMinimo.h"
+#include "reordenacao.h"
+#include "arquivoGrafo.h"
+#include "geradorGrafos.h"
+#include "nivelDetalhe.h"
+#include "dijkstraDenso.h"
+#include "floydWarshall.h"
+#include "consultasLote.h"
+#include "grafoCompacto.h"
+#include "reponderacaoJohnson.h"
+#include "kCaminhos.h"
+#include "metricasConsultas.h"
+
+using namespace std;
+
+typedef uint32_t Weight;
+typedef uint32_t VertexId;
+
+// Contador de hardware do perf; se não puder ser aberto, available() é false
+class PerfCounter {
+public:
+    PerfCounter(uint32_t type, uint64_t config) {
+        perf_event_attr attr;
+        memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.type = type;
+        attr.config = config;
+        attr.disabled = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        fd = (int)syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+    }
+    ~PerfCounter() {
+        if (fd >= 0) close(fd);
+    }
+
+    bool available() const { return fd >= 0; }
+
+    void start() {
+        if (fd < 0) return;
+        ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+        ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+    }
+
+    uint64_t stop() {
+        if (fd < 0) return 0;
+        ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+        uint64_t value = 0;
+        if (read(fd, &value, sizeof(value)) != sizeof(value)) return 0;
+        return value;
+    }
+
+private:
+    int fd;
+};
+
+// Embaralha os ids: a ordem de entrada passa a não ter relação com a geometria
+void shuffleVertices(Graph<Weight, VertexId>& graph, vector<Coordinate>& positions, mt19937_64& rng) {
+    VertexId n = graph.numVertices();
+    vector<VertexId> shuffle(n);
+    for (VertexId v = 0; v < n; ++v) shuffle[v] = v;
+    std::shuffle(shuffle.begin(), shuffle.end(), rng);
+
+    vector<Edge<Weight, VertexId>> edges;
+    edges.reserve(graph.numEdges());
+    for (VertexId v = 0; v < n; ++v)
+        for (size_t e = graph.offsets[v]; e < graph.offsets[(size_t)v + 1]; ++e)
+            edges.push_back({ shuffle[v], shuffle[graph.targets[e]], graph.weights[e] });
+    graph = Graph<Weight, VertexId>::fromEdges(n, edges);
+
+    if (positions.size() != n) return;
+    vector<Coordinate> shuffled(n);
+    for (VertexId v = 0; v < n; ++v) shuffled[shuffle[v]] = positions[v];
+    positions.swap(shuffled);
+}
+
+// Todos os pares numa matriz densa: V x Dijkstra denso contra Floyd–Warshall em
+// blocos com 1 thread e com todas; as distâncias precisam ser iguais
+int allPairsBenchmark(int n, int density, uint64_t seed) {
+    mt19937_64 rng(seed);
+    FloydWarshall serial(n, true, 1), parallel(n, true);
+    DenseDijkstra dijkstra(n);
+    size_t edges = 0;
+    for (int i = 0; i < n; ++i)
+        for (int j = 0; j < n; ++j)
+            if (i != j && (int)(rng() % 100) < density) {
+                int32_t w = 1 + (int32_t)(rng() % 1000);
+                serial.setEdge(i, j, w);
+                parallel.setEdge(i, j, w);
+                dijkstra.setEdge(i, j, w);
+                ++edges;
+            }
+    cout << "todos os pares: " << n << " vértices, " << edges << " arestas, "
+         << thread::hardware_concurrency() << " threads" << endl;
+
+    auto t0 = chrono::steady_clock::now();
+    uint64_t checksum = 0;
+    vector<int32_t> rows((size_t)n * n);
+    for (int s = 0; s < n; ++s) {
+        dijkstra.run(s);
+        for (int v = 0; v < n; ++v) rows[(size_t)s * n + v] = dijkstra.distance(v);
+    }
+    auto t1 = chrono::steady_clock::now();
+    serial.run();
+    auto t2 = chrono::steady_clock::now();
+    parallel.run();
+    auto t3 = chrono::steady_clock::now();
+
+    vector<int> path;
+    for (int s = 0; s < n; ++s)
+        for (int v = 0; v < n; ++v) {
+            int32_t d = rows[(size_t)s * n + v];
+            if (serial.distance(s, v) != d || parallel.distance(s, v) != d) {
+                cerr << "Erro: distância " << s << " -> " << v << " difere do Dijkstra" << endl;
+                return 1;
+            }
+            checksum += d;
+        }
+    // Os caminhos da matriz de próximos precisam somar a distância
+    for (int q = 0; q < 1000; ++q) {
+        int s = (int)(rng() % n), v = (int)(rng() % n);
+        parallel.buildPath(s, v, path);
+        int64_t sum = 0;
+        for (size_t i = 1; i < path.size(); ++i) sum += parallel.distance(path[i - 1], path[i]);
+        if (parallel.reached(s, v) && (path.size() > (size_t)n || sum != parallel.distance(s, v))) {
+            cerr << "Erro: caminho " << s << " -> " << v << " não tem o comprimento da distância" << endl;
+            return 1;
+        }
+    }
+
+    double base = chrono::duration<double, milli>(t1 - t0).count();
+    auto report = [base](const char* name, double ms) {
+        cout << left << setw(26) << name << right << fixed << setprecision(1) << setw(12) << ms << " ms  ("
+             << setprecision(2) << base / ms << "x)" << endl;
+    };
+    report("V x Dijkstra denso", base);
+    report("Floyd-Warshall, 1 thread", chrono::duration<double, milli>(t2 - t1).count());
+    report("Floyd-Warshall, todas", chrono::duration<double, milli>(t3 - t2).count());
+    cout << "soma das distâncias: " << checksum << endl;
+    return 0;
+}
+
+// Lote de consultas sobre um grafo geométrico: uma a uma com um motor, e com o
+// BatchRunner em 1 e em todas as threads; as distâncias precisam ser iguais
+int batchBenchmark(VertexId n, size_t count, VertexId distinctSources, uint64_t seed) {
+    mt19937_64 rng(seed);
+    Graph<Weight, VertexId> graph;
+    vector<Coordinate> positions;
+    GeneratorOptions options;
+    options.seed = seed;
+    GraphGenerator<Weight, VertexId>(options).generate(FAMILY_GEOMETRIC, (uint64_t)n * 8, graph, positions);
+    n = graph.numVertices();
+    graph = permuteGraph(graph, hilbertOrder(positions.data(), n));
+
+    vector<VertexId> sourcePool(max<VertexId>(1, min(distinctSources, n)));
+    for (auto& s : sourcePool) s = (VertexId)(rng() % n);
+    vector<BatchQuery<VertexId>> queries(count);
+    for (auto& q : queries) q = { sourcePool[rng() % sourcePool.size()], (VertexId)(rng() % n) };
+    cout << "lote: " << n << " vértices, " << graph.numEdges() << " arestas, " << count << " consultas de "
+         << sourcePool.size() << " origens, " << thread::hardware_concurrency() << " threads" << endl;
+
+    auto t0 = chrono::steady_clock::now();
+    DijkstraEngine<Weight, VertexId> engine(graph);
+    vector<DistanceOf<Weight>> expected(count);
+    for (size_t i = 0; i < count; ++i) {
+        engine.run(queries[i].source, queries[i].target);
+        expected[i] = engine.distance(queries[i].target);
+    }
+    auto t1 = chrono::steady_clock::now();
+    BatchRunner<Weight, VertexId> serial(graph, 1), parallel(graph);
+    vector<DistanceOf<Weight>> serialDistances, parallelDistances;
+    serial.run(queries, serialDistances);
+    auto t2 = chrono::steady_clock::now();
+    BatchPaths<VertexId> paths;
+    parallel.run(queries, parallelDistances, &paths);
+    auto t3 = chrono::steady_clock::now();
+
+    if (serialDistances != expected || parallelDistances != expected) {
+        cerr << "Erro: distâncias do lote diferentes das consultas uma a uma" << endl;
+        return 1;
+    }
+    for (size_t i = 0; i < count; ++i) {
+        size_t begin = paths.offsets[i], end = paths.offsets[i + 1];
+        bool ok = expected[i] == WeightTraits<DistanceOf<Weight>>::infinity()
+                      ? begin == end
+                      : end > begin && paths.vertices[begin] == queries[i].source &&
+                            paths.vertices[end - 1] == queries[i].target;
+        if (!ok) {
+            cerr << "Erro: caminho da consulta " << i << " fora de ordem" << endl;
+            return 1;
+        }
+    }
+
+    double base = chrono::duration<double, milli>(t1 - t0).count();
+    auto report = [base, count](const char* name, double ms) {
+        cout << left << setw(28) << name << right << fixed << setprecision(1) << setw(12) << ms << " ms"
+             << setw(12) << setprecision(0) << count / (ms / 1000.0) << " consultas/s  (" << setprecision(2)
+             << base / ms << "x)" << endl;
+    };
+    report("uma a uma", base);
+    report("lote, 1 thread", chrono::duration<double, milli>(t2 - t1).count());
+    report("lote com caminhos, todas", chrono::duration<double, milli>(t3 - t2).count());
+    return 0;
+}
+
+// Motor com pesos T no mesmo grafo (pesos já cabem em T): distâncias a todos os vértices
+// iguais às de referência, tempo por origem e memória do grafo
+template <typename T>
+bool checkWeightType(const char* name, const Graph<Weight, VertexId>& base, const vector<VertexId>& sources,
+                     const vector<vector<uint64_t>>& reference) {
+    Graph<T, VertexId> graph;
+    graph.offsets = base.offsets;
+    graph.targets = base.targets;
+    graph.weights.assign(base.weights.begin(), base.weights.end());
+    DijkstraEngine<T, VertexId> engine(graph);
+    double ms = 0;
+    for (size_t q = 0; q < sources.size(); ++q) {
+        auto start = chrono::steady_clock::now();
+        engine.run(sources[q]);
+        ms += chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+        for (VertexId v = 0; v < graph.numVertices(); ++v) {
+            bool same = engine.reached(v) ? reference[q][v] == (uint64_t)engine.distance(v)
+                                          : reference[q][v] == WeightTraits<uint64_t>::infinity();
+            if (!same) {
+                cerr << "Erro: pesos " << name << ": distância " << sources[q] << " -> " << v << " diferente" << endl;
+                return false;
+            }
+        }
+    }
+    cout << left << setw(10) << name << right << fixed << setprecision(1) << setw(10)
+         << graph.memoryBytes() / 1048576.0 << setw(16) << ms / sources.size() << endl;
+    return true;
+}
+
+// Um motor por tipo de peso (uint16/uint32/uint64/float/double) no mesmo grafo
+// geométrico, com os pesos reduzidos para caber em 16 bits. As distâncias são
+// acumuladas num tipo mais largo (DistanceOf), então caminhos acima de 65535 continuam
+// exatos com arestas de 16 bits.
+int weightTypesBenchmark(VertexId n, int queries, uint64_t seed) {
+    // Arestas de 16 bits somando além do alcance delas: 0 -> 1 -> 2 custa 80000
+    Graph<uint16_t, VertexId> chain = Graph<uint16_t, VertexId>::fromEdges(3, { { 0, 1, 40000 }, { 1, 2, 40000 } });
+    DijkstraEngine<uint16_t, VertexId> chainEngine(chain);
+    chainEngine.run(0);
+    if (!chainEngine.reached(2) || chainEngine.distance(2) != 80000) {
+        cerr << "Erro: caminho 0 -> 2 com pesos de 16 bits deveria custar 80000" << endl;
+        return 1;
+    }
+
+    mt19937_64 rng(seed);
+    Graph<Weight, VertexId> graph;
+    vector<Coordinate> positions;
+    GeneratorOptions options;
+    options.seed = seed;
+    GraphGenerator<Weight, VertexId>(options).generate(FAMILY_GEOMETRIC, (uint64_t)n * 8, graph, positions);
+    n = graph.numVertices();
+    graph = permuteGraph(graph, hilbertOrder(positions.data(), n));
+    Weight heaviest = graph.weights.empty() ? 1 : *max_element(graph.weights.begin(), graph.weights.end());
+    Weight scale = heaviest / 65535 + 1;
+    for (Weight& w : graph.weights) w /= scale;
+
+    vector<VertexId> sources(max(1, queries));
+    for (auto& s : sources) s = (VertexId)(rng() % n);
+    vector<vector<uint64_t>> reference(sources.size());
+    Graph<uint64_t, VertexId> wide;
+    wide.offsets = graph.offsets;
+    wide.targets = graph.targets;
+    wide.weights.assign(graph.weights.begin(), graph.weights.end());
+    DijkstraEngine<uint64_t, VertexId> referenceEngine(wide);
+    uint64_t longest = 0;
+    for (size_t q = 0; q < sources.size(); ++q) {
+        referenceEngine.run(sources[q]);
+        reference[q].resize(n);
+        for (VertexId v = 0; v < n; ++v) {
+            reference[q][v] = referenceEngine.distance(v);
+            if (referenceEngine.reached(v)) longest = max(longest, reference[q][v]);
+        }
+    }
+    cout << "tipos de peso: " << n << " vértices, " << graph.numEdges() << " arestas, maior distância " << longest
+         << endl;
+    cout << left << setw(10) << "peso" << right << setw(10) << "MiB" << setw(16) << "ms por origem" << endl;
+    bool ok = checkWeightType<uint16_t>("uint16", graph, sources, reference) &&
+              checkWeightType<uint32_t>("uint32", graph, sources, reference) &&
+              checkWeightType<uint64_t>("uint64", graph, sources, reference) &&
+              checkWeightType<float>("float", graph, sources, reference) &&
+              checkWeightType<double>("double", graph, sources, reference);
+    return ok ? 0 : 1;
+}
+
+// Grafo geométrico com pesos w(u, v) + p(u) - p(v), p aleatório: há arestas negativas,
+// mas cada ciclo mantém o peso original (positivo) e d(s, t) = d0(s, t) + p(s) - p(t)
+void negativeGeometric(VertexId n, uint64_t seed, Graph<Weight, VertexId>& base, Graph<int32_t, VertexId>& graph,
+                       vector<int32_t>& shift) {
+    mt19937_64 rng(seed);
+    vector<Coordinate> positions;
+    GeneratorOptions options;
+    options.seed = seed;
+    GraphGenerator<Weight, VertexId>(options).generate(FAMILY_GEOMETRIC, (uint64_t)n * 8, base, positions);
+    n = base.numVertices();
+    base = permuteGraph(base, hilbertOrder(positions.data(), n));
+    uint64_t mean = 0;
+    for (Weight w : base.weights) mean += w;
+    mean = mean / max<size_t>(1, base.numEdges()) + 1;
+    shift.resize(n);
+    for (auto& p : shift) p = (int32_t)(rng() % (4 * mean));
+    graph.offsets = base.offsets;
+    graph.targets = base.targets;
+    graph.weights.resize(base.numEdges());
+    for (VertexId u = 0; u < n; ++u)
+        for (size_t e = base.offsets[u]; e < base.offsets[(size_t)u + 1]; ++e)
+            graph.weights[e] = (int32_t)base.weights[e] + shift[u] - shift[base.targets[e]];
+}
+
+// Johnson: potenciais, consultas no grafo reponderado conferidas contra o grafo sem
+// deslocamento, detecção de um ciclo negativo inserido e todos os pares esparsos
+int johnsonBenchmark(VertexId n, VertexId allPairsN, uint64_t seed) {
+    typedef JohnsonReweighting<int32_t, VertexId> Johnson;
+    typedef Johnson::Wide Wide; // distâncias originais (podem não caber em int32)
+    const Wide INF = WeightTraits<Wide>::infinity();
+    Graph<Weight, VertexId> base;
+    Graph<int32_t, VertexId> graph;
+    vector<int32_t> shift;
+    negativeGeometric(n, seed, base, graph, shift);
+    n = graph.numVertices();
+    size_t negative = count_if(graph.weights.begin(), graph.weights.end(), [](int32_t w) { return w < 0; });
+    cout << "johnson: " << n << " vértices, " << graph.numEdges() << " arestas (" << negative << " negativas)" << endl;
+
+    auto t0 = chrono::steady_clock::now();
+    Johnson johnson(graph);
+    if (!johnson.computePotentials()) {
+        cerr << "Erro: ciclo negativo num grafo sem ciclos negativos" << endl;
+        return 1;
+    }
+    auto t1 = chrono::steady_clock::now();
+    Graph<int32_t, VertexId> costs = johnson.reweighted();
+    auto t2 = chrono::steady_clock::now();
+
+    DijkstraEngine<Weight, VertexId> reference(base);
+    DijkstraEngine<int32_t, VertexId> engine(costs);
+    mt19937_64 rng(seed);
+    double queryTime = 0;
+    const int QUERIES = 5;
+    for (int q = 0; q < QUERIES; ++q) {
+        VertexId s = (VertexId)(rng() % n);
+        reference.run(s);
+        auto start = chrono::steady_clock::now();
+        engine.run(s);
+        queryTime += chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+        for (VertexId t = 0; t < n; ++t) {
+            Wide d = johnson.originalDistance(s, t, engine.distance(t));
+            Wide expected = reference.reached(t) ? (Wide)reference.distance(t) + shift[s] - shift[t] : INF;
+            if (d != expected) {
+                cerr << "Erro: distância " << s << " -> " << t << " reponderada difere da original" << endl;
+                return 1;
+            }
+        }
+    }
+
+    // A* do Yen no grafo reponderado (em 64 bits, via reweighted<R>): mesmos custos que no
+    // grafo sem deslocamento, e cada caminho custa no grafo original o que originalDistance() diz
+    auto edgeWeight = [](const Graph<int32_t, VertexId>& g, VertexId u, VertexId v) {
+        int64_t best = INT64_MAX;
+        for (size_t e = g.offsets[u]; e < g.offsets[(size_t)u + 1]; ++e)
+            if (g.targets[e] == v) best = min<int64_t>(best, g.weights[e]);
+        return best;
+    };
+    {
+        Graph<int64_t, VertexId> wideCosts = johnson.reweighted<int64_t>();
+        YenKShortest<Weight, VertexId> yenReference(base);
+        YenKShortest<int64_t, VertexId> yen(wideCosts);
+        vector<RankedPath<Weight, VertexId>> expectedPaths;
+        vector<RankedPath<int64_t, VertexId>> paths;
+        const size_t K = 8;
+        for (int q = 0; q < QUERIES; ++q) {
+            VertexId s = (VertexId)(rng() % n), t = (VertexId)(rng() % n);
+            yenReference.run(s, t, K, expectedPaths);
+            yen.run(s, t, K, paths);
+            bool ok = paths.size() == expectedPaths.size();
+            for (size_t i = 0; ok && i < paths.size(); ++i) {
+                Wide cost = johnson.originalDistance(s, t, paths[i].cost);
+                int64_t sum = 0;
+                for (size_t j = 0; j + 1 < paths[i].vertices.size(); ++j)
+                    sum += edgeWeight(graph, paths[i].vertices[j], paths[i].vertices[j + 1]);
+                ok = cost == (Wide)expectedPaths[i].cost + shift[s] - shift[t] && sum == cost;
+            }
+            if (!ok) {
+                cerr << "Erro: k caminhos " << s << " -> " << t << " reponderados diferem dos originais" << endl;
+                return 1;
+            }
+        }
+    }
+
+    // Aresta t -> s com peso -(d(s, t) + 1) fecha um ciclo de peso -1
+    VertexId s = 0, t = 0;
+    engine.run(s);
+    for (VertexId v = 0; v < n; ++v)
+        if (engine.reached(v) && v != s) t = v;
+    vector<Edge<int32_t, VertexId>> edges;
+    for (VertexId u = 0; u < n; ++u)
+        for (size_t e = graph.offsets[u]; e < graph.offsets[(size_t)u + 1]; ++e)
+            edges.push_back({ u, graph.targets[e], graph.weights[e] });
+    edges.push_back({ t, s, (int32_t)(-johnson.originalDistance(s, t, engine.distance(t)) - 1) });
+    Graph<int32_t, VertexId> cyclic = Graph<int32_t, VertexId>::fromEdges(n, edges);
+    auto t3 = chrono::steady_clock::now();
+    Johnson detector(cyclic);
+    bool found = !detector.computePotentials();
+    auto t4 = chrono::steady_clock::now();
+    const vector<VertexId>& cycle = detector.negativeCycle();
+    int64_t cycleWeight = 0;
+    for (size_t i = 0; found && i < cycle.size(); ++i) {
+        VertexId u = cycle[i], v = cycle[(i + 1) % cycle.size()];
+        int64_t best = edgeWeight(cyclic, u, v);
+        found = best != INT64_MAX;
+        cycleWeight += best;
+    }
+    if (!found || cycleWeight >= 0) {
+        cerr << "Erro: ciclo negativo não encontrado ou inválido" << endl;
+        return 1;
+    }
+
+    cout << fixed << setprecision(1) << "potenciais (SPFA): " << chrono::duration<double, milli>(t1 - t0).count()
+         << " ms, reponderação: " << chrono::duration<double, milli>(t2 - t1).count()
+         << " ms, Dijkstra reponderado: " << queryTime / QUERIES << " ms por origem" << endl;
+    cout << "ciclo negativo de " << cycle.size() << " vértices (peso " << cycleWeight << ") encontrado em "
+         << chrono::duration<double, milli>(t4 - t3).count() << " ms" << endl;
+
+    // Todos os pares num grafo menor: V Dijkstras reponderados contra Floyd–Warshall
+    // nos pesos originais (que não aceita negativos)
+    negativeGeometric(allPairsN, seed + 1, base, graph, shift);
+    allPairsN = graph.numVertices();
+    auto t5 = chrono::steady_clock::now();
+    Johnson sparse(graph);
+    vector<Wide> distances;
+    if (!sparse.computePotentials()) {
+        cerr << "Erro: ciclo negativo num grafo sem ciclos negativos" << endl;
+        return 1;
+    }
+    sparse.allPairs(distances);
+    auto t6 = chrono::steady_clock::now();
+    FloydWarshall fw((int)allPairsN, false);
+    for (VertexId u = 0; u < allPairsN; ++u)
+        for (size_t e = base.offsets[u]; e < base.offsets[(size_t)u + 1]; ++e)
+            fw.setEdge((int)u, (int)base.targets[e], (int32_t)base.weights[e]);
+    auto t7 = chrono::steady_clock::now();
+    fw.run();
+    auto t8 = chrono::steady_clock::now();
+    for (VertexId u = 0; u < allPairsN; ++u)
+        for (VertexId v = 0; v < allPairsN; ++v) {
+            Wide expected = fw.reached((int)u, (int)v) ? (Wide)fw.distance((int)u, (int)v) + shift[u] - shift[v] : INF;
+            if (distances[(size_t)u * allPairsN + v] != expected) {
+                cerr << "Erro: todos os pares " << u << " -> " << v << " difere do Floyd-Warshall" << endl;
+                return 1;
+            }
+        }
+
+    // Dijkstra denso sobre a matriz dos pesos reponderados, conferido contra allPairs()
+    Graph<int32_t, VertexId> sparseCosts = sparse.reweighted();
+    DenseDijkstra dense((int)allPairsN);
+    vector<int32_t> matrix((size_t)allPairsN * allPairsN, DenseDijkstra::INF_DIST);
+    for (VertexId u = 0; u < allPairsN; ++u)
+        for (size_t e = sparseCosts.offsets[u]; e < sparseCosts.offsets[(size_t)u + 1]; ++e) {
+            int32_t& cell = matrix[(size_t)u * allPairsN + sparseCosts.targets[e]];
+            cell = min(cell, sparseCosts.weights[e]);
+        }
+    for (VertexId u = 0; u < allPairsN; ++u)
+        for (VertexId v = 0; v < allPairsN; ++v)
+            if (matrix[(size_t)u * allPairsN + v] < DenseDijkstra::INF_DIST)
+                dense.setEdge((int)u, (int)v, matrix[(size_t)u * allPairsN + v]);
+    for (int q = 0; q < QUERIES; ++q) {
+        VertexId s = (VertexId)(rng() % allPairsN);
+        dense.run((int)s);
+        for (VertexId v = 0; v < allPairsN; ++v) {
+            Wide d = dense.reached((int)v) ? sparse.originalDistance(s, v, dense.distance((int)v)) : INF;
+            if (distances[(size_t)s * allPairsN + v] != d) {
+                cerr << "Erro: Dijkstra denso " << s << " -> " << v << " reponderado difere dos todos os pares" << endl;
+                return 1;
+            }
+        }
+    }
+    cout << "todos os pares (" << allPairsN << " vértices, " << graph.numEdges() << " arestas, "
+         << thread::hardware_concurrency() << " threads): Johnson " << chrono::duration<double, milli>(t6 - t5).count()
+         << " ms, Floyd-Warshall " << chrono::duration<double, milli>(t8 - t7).count() << " ms" << endl;
+    return 0;
+}
+
+int main(int argc, char** argv) {
+    if (argc > 1 && string(argv[1]) == "--johnson")
+        return johnsonBenchmark(argc > 2 ? (VertexId)atoi(argv[2]) : 100000, argc > 3 ? (VertexId)atoi(argv[3]) : 2048,
+                                argc > 4 ? strtoull(argv[4], nullptr, 10) : 42);
+    if (argc > 1 && string(argv[1]) == "--tipos")
+        return weightTypesBenchmark(argc > 2 ? (VertexId)atoi(argv[2]) : 200000, argc > 3 ? atoi(argv[3]) : 5,
+                                    argc > 4 ? strtoull(argv[4], nullptr, 10) : 42);
+    if (argc > 1 && string(argv[1]) == "--lote")
+        return batchBenchmark(argc > 2 ? (VertexId)atoi(argv[2]) : 30000, argc > 3 ? (size_t)atol(argv[3]) : 5000,
+                              argc > 4 ? (VertexId)atoi(argv[4]) : 200, argc > 5 ? strtoull(argv[5], nullptr, 10) : 42);
+    if (argc > 1 && string(argv[1]) == "--todos-pares")
+        return allPairsBenchmark(argc > 2 ? atoi(argv[2]) : 2048, argc > 3 ? atoi(argv[3]) : 25,
+                                 argc > 4 ? strtoull(argv[4], nullptr, 10) : 42);
+
+    // Primeiro argumento: número de vértices do grafo geométrico gerado, ou um arquivo
+    string input = argc > 1 ? argv[1] : "1000000";
+    int queries = argc > 2 ? atoi(argv[2]) : 20;
+    uint64_t seed = argc > 3 ? strtoull(argv[3], nullptr, 10) : 42;
+
+    mt19937_64 rng(seed);
+    Graph<Weight, VertexId> graph;
+    vector<Coordinate> positions;
+    if (input.find_first_not_of("0123456789") == string::npos) {
+        GeneratorOptions options;
+        options.seed = seed;
+        GraphGenerator<Weight, VertexId>(options).generate(FAMILY_GEOMETRIC, strtoull(input.c_str(), nullptr, 10) * 8,
+                                                           graph, positions);
+        shuffleVertices(graph, positions, rng);
+    } else if (!loadGraph(input, graph, positions)) {
+        return 1;
+    }
+    VertexId n = graph.numVertices();
+    if (n == 0 || queries <= 0) {
+        cerr << "Erro: grafo vazio ou número de consultas inválido" << endl;
+        return 1;
+    }
+    cout << "grafo: " << n << " vértices, " << graph.numEdges() << " arestas, " << queries << " consultas" << endl;
+
+    vector<VertexId> sources(queries);
+    for (auto& s : sources) s = (VertexId)(rng() % n);
+
+    PerfCounter l1Misses(PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                                                 (PERF_COUNT_HW_CACHE_RESULT_MISS << 16));
+    PerfCounter llcMisses(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES);
+    if (!l1Misses.available() || !llcMisses.available())
+        cerr << "Aviso: contadores de cache indisponíveis (perf_event_paranoid?); só o tempo será medido" << endl;
+
+    const char* names[] = { "original", "BFS", "RCM", "Hilbert" };
+    double baseTime = 0;
+    uint64_t baseL1 = 0, baseLlc = 0, baseChecksum = 0;
+
+    cout << left << setw(10) << "ordem" << right << setw(12) << "prep (ms)" << setw(12) << "busca (ms)"
+         << setw(16) << "faltas L1D" << setw(16) << "faltas LLC" << setw(10) << "LLC" << endl;
+
+    for (int kind = ORDER_IDENTITY; kind <= ORDER_HILBERT; ++kind) {
+        auto t0 = chrono::steady_clock::now();
+        VertexOrder<VertexId> order;
+        switch (kind) {
+            case ORDER_BFS: order = bfsOrder(graph); break;
+            case ORDER_RCM: order = rcmOrder(graph); break;
+            case ORDER_HILBERT:
+                if (positions.size() != n) continue; // arquivo sem posições
+                order = hilbertOrder(positions.data(), n);
+                break;
+            default: order = VertexOrder<VertexId>::identity(n); break;
+        }
+        Graph<Weight, VertexId> g = permuteGraph(graph, order);
+        auto t1 = chrono::steady_clock::now();
+
+        DijkstraEngine<Weight, VertexId> engine(g);
+        engine.run(order.toNew[sources[0]]); // aquece o workspace
+
+        uint64_t checksum = 0;
+        l1Misses.start();
+        llcMisses.start();
+        auto t2 = chrono::steady_clock::now();
+        for (VertexId s : sources) {
+            engine.run(order.toNew[s]);
+            checksum += engine.reached(order.toNew[(s + 1) % n]);
+            checksum += engine.distance(order.toNew[(s * 7 + 3) % n]);
+        }
+        auto t3 = chrono::steady_clock::now();
+        uint64_t l1 = l1Misses.stop();
+        uint64_t llc = llcMisses.stop();
+
+        double prep = chrono::duration<double, milli>(t1 - t0).count();
+        double time = chrono::duration<double, milli>(t3 - t2).count();
+        if (kind == ORDER_IDENTITY) {
+            baseTime = time;
+            baseL1 = l1;
+            baseLlc = llc;
+            baseChecksum = checksum;
+        } else if (checksum != baseChecksum) {
+            cerr << "Erro: distâncias diferentes com a ordem " << names[kind] << endl;
+            return 1;
+        }
+
+        cout << left << setw(10) << names[kind] << right << fixed << setprecision(1) << setw(12) << prep
+             << setw(12) << time;
+        if (l1Misses.available()) cout << setw(16) << l1;
+        else cout << setw(16) << "n/d";
+        if (llcMisses.available()) cout << setw(16) << llc;
+        else cout << setw(16) << "n/d";
+        if (baseLlc > 0) cout << setw(9) << 100.0 * llc / baseLlc << "%";
+        cout << "   (" << setprecision(2) << baseTime / time << "x";
+        if (baseL1 > 0) cout << ", L1D " << setprecision(0) << 100.0 * l1 / baseL1 << "%";
+        cout << ")" << endl;
+    }
+
+    // Grafo comprimido na melhor ordem disponível contra o CSR na mesma ordem
+    {
+        VertexOrder<VertexId> order = positions.size() == n ? hilbertOrder(positions.data(), n) : rcmOrder(graph);
+        Graph<Weight, VertexId> g = permuteGraph(graph, order);
+        auto t0 = chrono::steady_clock::now();
+        CompressedGraph<Weight, VertexId> compressed = CompressedGraph<Weight, VertexId>::fromGraph(g);
+        double build = chrono::duration<double, milli>(chrono::steady_clock::now() - t0).count();
+
+        auto timeQueries = [&](auto& engine, uint64_t& checksum, QueryMetrics& metrics) {
+            engine.run(order.toNew[sources[0]]);
+            checksum = 0;
+            auto start = chrono::steady_clock::now();
+            for (VertexId s : sources) {
+                engine.run(order.toNew[s]);
+                metrics.record(engine.stats());
+                checksum += engine.reached(order.toNew[(s + 1) % n]);
+                checksum += engine.distance(order.toNew[(s * 7 + 3) % n]);
+            }
+            return chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+        };
+        DijkstraEngine<Weight, VertexId> csrEngine(g);
+        DijkstraEngine<Weight, VertexId, CompressedGraph<Weight, VertexId>> compressedEngine(compressed);
+        uint64_t csrChecksum, compressedChecksum;
+        QueryMetrics csrMetrics, compressedMetrics;
+        double csrTime = timeQueries(csrEngine, csrChecksum, csrMetrics);
+        double compressedTime = timeQueries(compressedEngine, compressedChecksum, compressedMetrics);
+        if (compressedChecksum != csrChecksum || compressedMetrics.settled.valueSum() != csrMetrics.settled.valueSum()) {
+            cerr << "Erro: distâncias diferentes no grafo comprimido" << endl;
+            return 1;
+        }
+        // Fora da medição: toda a adjacência decodificada e as distâncias a todos os
+        // vértices, para cada origem, iguais às do CSR
+        vector<pair<VertexId, Weight>> expected, decoded;
+        for (VertexId v = 0; v < n; ++v) {
+            expected.clear();
+            decoded.clear();
+            for (size_t e = g.offsets[v]; e < g.offsets[(size_t)v + 1]; ++e)
+                expected.push_back({ g.targets[e], g.weights[e] });
+            sort(expected.begin(), expected.end());
+            compressed.forEachNeighbor(v, [&](VertexId w, Weight weight) { decoded.push_back({ w, weight }); });
+            if (decoded != expected) {
+                cerr << "Erro: vizinhos do vértice " << v << " diferentes no grafo comprimido" << endl;
+                return 1;
+            }
+        }
+        for (VertexId s : sources) {
+            csrEngine.run(order.toNew[s]);
+            compressedEngine.run(order.toNew[s]);
+            for (VertexId v = 0; v < n; ++v)
+                if (csrEngine.distance(v) != compressedEngine.distance(v)) {
+                    cerr << "Erro: distância " << s << " -> " << v << " diferente no grafo comprimido" << endl;
+                    return 1;
+                }
+        }
+
+        double edges = (double)max<size_t>(1, g.numEdges());
+        cout << "\ngrafo comprimido (" << (positions.size() == n ? "Hilbert" : "RCM") << ", montado em " << fixed
+             << setprecision(1) << build << " ms)" << endl;
+        cout << left << setw(12) << "formato" << right << setw(12) << "MiB" << setw(14) << "bytes/aresta"
+             << setw(12) << "busca (ms)" << endl;
+        cout << left << setw(12) << "CSR" << right << setw(12) << g.memoryBytes() / 1048576.0 << setw(14)
+             << setprecision(2) << g.memoryBytes() / edges << setw(12) << setprecision(1) << csrTime << endl;
+        cout << left << setw(12) << "comprimido" << right << setw(12) << compressed.memoryBytes() / 1048576.0
+             << setw(14) << setprecision(2) << compressed.memoryBytes() / edges << setw(12) << setprecision(1)
+             << compressedTime << "   (" << setprecision(2) << (double)g.memoryBytes() / compressed.memoryBytes()
+             << "x menos memória, " << setprecision(0) << 100.0 * (compressedTime / csrTime - 1) << "% no tempo)"
+             << endl;
+
+        // Trabalho por consulta (SearchStats), agregado como no servidor
+        cout << "\nestatísticas por consulta (CSR)" << endl;
+        cout << left << setw(16) << "contador" << right << setw(14) << "média" << setw(12) << "p50" << setw(12)
+             << "p99" << setw(12) << "máx" << endl;
+        const pair<const char*, const LatencyHistogram*> rows[] = {
+            { "fixados", &csrMetrics.settled },           { "arestas", &csrMetrics.relaxed },
+            { "decrease-key", &csrMetrics.decreaseKeys }, { "pico do heap", &csrMetrics.heapPeak },
+            { "bytes alocados", &csrMetrics.bytesAllocated }, { "tempo (µs)", &csrMetrics.duration },
+        };
+        for (const auto& row : rows) {
+            double scale = row.second == &csrMetrics.duration ? 1e-3 : 1.0;
+            cout << left << setw(16) << row.first << right << setprecision(0) << setw(14) << row.second->mean() * scale
+                 << setw(12) << row.second->percentile(0.5) * scale << setw(12) << row.second->percentile(0.99) * scale
+                 << setw(12) << row.second->max() * scale << endl;
+        }
+    }
+
+    // Níveis de detalhe: construção e primitivas da visão inteira numa tela 1920x1080
+    if (positions.size() == n) {
+        auto t0 = chrono::steady_clock::now();
+        ClusterHierarchy<VertexId> lod;
+        lod.build(graph, positions.data());
+        double build = chrono::duration<double, milli>(chrono::steady_clock::now() - t0).count();
+        cout << "\nníveis de detalhe: " << lod.numLevels() << " níveis em " << fixed << setprecision(1) << build
+             << " ms" << endl;
+        cout << right << setw(10) << "células" << setw(12) << "clusters" << setw(12) << "feixes" << endl;
+        for (size_t l = 0; l < lod.numLevels(); ++l)
+            cout << setw(10) << lod.level(l).resolution << setw(12) << lod.level(l).centers.size() << setw(12)
+                 << lod.level(l).bundles.size() << endl;
+        size_t level;
+        float t;
+        if (lod.chooseLevel(1080.0f, 8.0f, level, t))
+            cout << "visão inteira (células de 8 px): " << lod.level(level).centers.size() << " discos e "
+                 << lod.level(level).bundles.size() << " feixes em vez de " << n << " discos e " << graph.numEdges()
+                 << " arestas" << endl;
+    }
+    return 0;
+}
@@ -0,0 +1,232 @@
+#ifndef BUSCA_LARGURA_H
+#define BUSCA_LARGURA_H
+
+// Busca em largura para grafos em que todas as arestas têm o mesmo peso.
+// Fronteiras e visitados são bitsets de 64 bits e cada nível escolhe entre
+// top-down (expande a fronteira) e bottom-up (cada não visitado procura um pai
+// na fronteira pelas arestas de entrada), como em Beamer et al. As threads são
+// criadas uma vez por busca, cada uma com uma faixa fixa de palavras do bitset, e
+// sincronizadas por uma barreira entre as fases de cada nível.
+// O resultado tem as mesmas distâncias do Dijkstra e, como pai, sempre o vértice
+// de menor índice no nível anterior, independente do número de threads.
+
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+#include <algorithm>
+#include "caminhoMinimo.h"
+#include "barreiraFases.h"
+
+// Verifica se todas as arestas têm o mesmo peso (e devolve esse peso)
+template <typename W, typename Index>
+bool uniformWeight(const Graph<W, Index>& graph, W& weight) {
+    if (graph.weights.empty()) return false;
+    weight = graph.weights[0];
+    for (W w : graph.weights)
+        if (w != weight) return false;
+    return true;
+}
+
+template <typename W, typename Index = uint32_t>
+class BfsEngine {
+public:
+    typedef WeightTraits<W> Traits;
+
+    static constexpr uint32_t UNREACHED = UINT32_MAX;
+    static constexpr size_t ALPHA = 14;                  // limiar top-down -> bottom-up
+    static constexpr size_t BETA = 24;                   // limiar bottom-up -> top-down
+    static constexpr size_t PARALLEL_MIN_WORDS = 1024;   // abaixo disso roda em uma thread
+
+    BfsEngine(const Graph<W, Index>& graph, W unitWeight, unsigned threads = 0)
+        : graph(&graph), unitWeight(unitWeight),
+          threads(threads ? threads : std::max(1u, std::thread::hardware_concurrency())) {
+        buildReverse();
+    }
+
+    template <typename Stop>
+    bool run(Index source, Index target, Stop stop) {
+        size_t n = graph->numVertices();
+        size_t words = (n + 63) / 64;
+        level.assign(n, UNREACHED);
+        path.assign(n, noVertex<Index>());
+        visited.assign(words, 0);
+        layers[0].assign(words, 0);
+        layers[1].assign(words, 0);
+
+        setBit(visited, source);
+        setBit(layers[0], source);
+        level[source] = 0;
+        if (stop()) return false;
+
+        unsigned t = words < PARALLEL_MIN_WORDS ? 1 : (unsigned)std::min<size_t>(threads, words);
+        size_t chunk = (words + t - 1) / t;
+        sizes.assign(t, 0);
+        edges.assign(t, 0);
+        sizes[0] = 1;
+        edges[0] = degree(source);
+        PhaseBarrier barrier(t);
+        std::atomic<bool> cancelled{ false };
+
+        // Cada thread decide sozinha quando parar e a direção do nível, a partir dos
+        // totais gravados antes da barreira; todas chegam à mesma decisão
+        auto work = [&](unsigned k) {
+            size_t begin = std::min(words, k * chunk), end = std::min(words, (k + 1) * chunk);
+            size_t unexploredEdges = graph->numEdges();
+            bool bottomUp = false;
+            for (uint32_t depth = 0;; ++depth) {
+                size_t frontierSize = 0, frontierEdges = 0;
+                for (unsigned j = 0; j < t; ++j) {
+                    frontierSize += sizes[j];
+                    frontierEdges += edges[j];
+                }
+                unexploredEdges -= std::min(unexploredEdges, frontierEdges);
+                if (frontierSize == 0 || cancelled.load(std::memory_order_relaxed)) break;
+                if (target != noVertex<Index>() && level[target] != UNREACHED) break;
+
+                if (!bottomUp && frontierEdges > unexploredEdges / ALPHA) bottomUp = true;
+                else if (bottomUp && frontierSize < n / BETA) bottomUp = false;
+
+                std::vector<uint64_t>& frontier = layers[depth & 1];
+                std::vector<uint64_t>& next = layers[(depth + 1) & 1];
+                if (bottomUp) stepBottomUp(frontier, next, begin, end);
+                else stepTopDown(frontier, next, begin, end);
+                barrier.wait();
+
+                // Entre as barreiras ninguém lê cancelled: a resposta de stop() vale
+                // para todas as threads no início do próximo nível
+                if (k == 0 && stop()) cancelled.store(true, std::memory_order_relaxed);
+                commitLevel(frontier, next, depth + 1, begin, end, k);
+                barrier.wait();
+            }
+        };
+        std::vector<std::thread> pool;
+        for (unsigned k = 1; k < t; ++k) pool.emplace_back(work, k);
+        work(0);
+        for (auto& th : pool) th.join();
+        return !cancelled.load(std::memory_order_relaxed);
+    }
+
+    bool run(Index source, Index target = noVertex<Index>()) {
+        return run(source, target, [] { return false; });
+    }
+
+    bool reached(Index v) const { return level[v] != UNREACHED; }
+    Index predecessor(Index v) const { return path[v]; }
+    uint32_t hops(Index v) const { return level[v]; }
+
+    // Distância = número de arestas * peso único (saturada em infinito)
+    W distance(Index v) const {
+        if (!reached(v)) return Traits::infinity();
+        W d = 0;
+        if constexpr (std::is_floating_point<W>::value) {
+            d = (W)level[v] * unitWeight;
+        } else {
+            // Em 64 bits: com W estreito (uint16_t) o cast do nível para W daria a volta
+            uint64_t unit = (uint64_t)unitWeight;
+            if (unit != 0 && (uint64_t)level[v] > (uint64_t)Traits::infinity() / unit) return Traits::infinity();
+            d = (W)((uint64_t)level[v] * unit);
+        }
+        return d;
+    }
+
+    void buildPath(Index target, std::vector<Index>& out) const {
+        out.clear();
+        if (!reached(target)) return;
+        for (Index current = target; current != noVertex<Index>(); current = path[current])
+            out.push_back(current);
+        std::reverse(out.begin(), out.end());
+    }
+
+private:
+    size_t degree(Index v) const { return graph->offsets[(size_t)v + 1] - graph->offsets[v]; }
+
+    static void setBit(std::vector<uint64_t>& bits, size_t v) { bits[v >> 6] |= 1ull << (v & 63); }
+    static bool testBit(const std::vector<uint64_t>& bits, size_t v) { return (bits[v >> 6] >> (v & 63)) & 1; }
+
+    // Arestas de entrada em CSR, com as origens em ordem crescente
+    void buildReverse() {
+        size_t n = graph->numVertices();
+        inOffsets.assign(n + 1, 0);
+        for (Index w : graph->targets) inOffsets[(size_t)w + 1]++;
+        for (size_t v = 0; v < n; ++v) inOffsets[v + 1] += inOffsets[v];
+
+        inSources.resize(graph->numEdges());
+        std::vector<size_t> fill(inOffsets.begin(), inOffsets.end() - 1);
+        for (size_t v = 0; v < n; ++v)
+            for (size_t e = graph->offsets[v]; e < graph->offsets[v + 1]; ++e)
+                inSources[fill[graph->targets[e]]++] = (Index)v;
+    }
+
+    // Cada vértice da fronteira em [begin, end) marca os vizinhos não visitados; entre
+    // vários pais no mesmo nível fica o de menor índice (CAS de mínimo)
+    void stepTopDown(const std::vector<uint64_t>& frontier, std::vector<uint64_t>& next, size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            for (uint64_t bits = frontier[i]; bits; bits &= bits - 1) {
+                Index u = (Index)(i * 64 + __builtin_ctzll(bits));
+                for (size_t e = graph->offsets[u]; e < graph->offsets[(size_t)u + 1]; ++e) {
+                    Index w = graph->targets[e];
+                    if (testBit(visited, w)) continue;
+                    __atomic_fetch_or(&next[w >> 6], 1ull << (w & 63), __ATOMIC_RELAXED);
+                    Index current = __atomic_load_n(&path[w], __ATOMIC_RELAXED);
+                    while (u < current &&
+                           !__atomic_compare_exchange_n(&path[w], &current, u, true,
+                                                        __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {}
+                }
+            }
+        }
+    }
+
+    // Cada vértice não visitado em [begin, end) procura o primeiro pai (menor índice) na fronteira
+    void stepBottomUp(const std::vector<uint64_t>& frontier, std::vector<uint64_t>& next, size_t begin, size_t end) {
+        size_t n = graph->numVertices();
+        for (size_t i = begin; i < end; ++i) {
+            uint64_t unvisited = ~visited[i];
+            if (i == visited.size() - 1 && (n & 63)) unvisited &= (1ull << (n & 63)) - 1;
+            for (; unvisited; unvisited &= unvisited - 1) {
+                size_t v = i * 64 + __builtin_ctzll(unvisited);
+                for (size_t e = inOffsets[v]; e < inOffsets[v + 1]; ++e) {
+                    Index u = inSources[e];
+                    if (testBit(frontier, u)) {
+                        path[v] = u;
+                        next[i] |= 1ull << (v & 63);
+                        break;
+                    }
+                }
+            }
+        }
+    }
+
+    // Marca o novo nível em [begin, end) como visitado, mede tamanho e arestas da nova
+    // fronteira (na posição k) e zera a fronteira antiga, que vira o próximo next
+    void commitLevel(std::vector<uint64_t>& frontier, const std::vector<uint64_t>& next, uint32_t depth,
+                     size_t begin, size_t end, unsigned k) {
+        size_t size = 0, frontierEdges = 0;
+        for (size_t i = begin; i < end; ++i) {
+            visited[i] |= next[i];
+            frontier[i] = 0;
+            for (uint64_t bits = next[i]; bits; bits &= bits - 1) {
+                Index v = (Index)(i * 64 + __builtin_ctzll(bits));
+                level[v] = depth;
+                ++size;
+                frontierEdges += degree(v);
+            }
+        }
+        sizes[k] = size;
+        edges[k] = frontierEdges;
+    }
+
+    const Graph<W, Index>* graph;
+    W unitWeight;
+    unsigned threads;
+    std::vector<size_t> inOffsets;
+    std::vector<Index> inSources;
+    std::vector<uint32_t> level;
+    std::vector<Index> path;
+    std::vector<uint64_t> visited;
+    std::vector<uint64_t> layers[2];  // fronteira do nível d em layers[d % 2], a seguinte na outra
+    std::vector<size_t> sizes, edges; // por thread: vértices e arestas da nova fronteira
+};
+
+#endif
@@ -0,0 +1,422 @@
+#ifndef CAMINHO_MINIMO_H
+#define CAMINHO_MINIMO_H
+
+// Motor de caminhos mínimos parametrizado pelo tipo do peso e do índice de vértice.
+// Cada combinação (ex.: Graph<uint16_t, uint32_t>) gera código próprio em tempo de
+// compilação, então pesos de 16 bits realmente ocupam metade da memória. Distâncias
+// acumuladas usam um tipo próprio, mais largo (DistanceOf): só as arestas ficam estreitas.
+
+#include <vector>
+#include <memory>
+#include <limits>
+#include <cstdint>
+#include <cstddef>
+#include <chrono>
+#include <algorithm>
+#include <type_traits>
+#include <functional>
+
+// Infinito e soma sem overflow para cada tipo de peso
+template <typename W>
+struct WeightTraits {
+    static_assert(std::is_arithmetic<W>::value, "peso precisa ser numérico");
+
+    static constexpr W infinity() {
+        return std::numeric_limits<W>::has_infinity ? std::numeric_limits<W>::infinity()
+                                                    : std::numeric_limits<W>::max();
+    }
+
+    // Soma saturada: qualquer resultado que não caiba vira infinito
+    static W add(W a, W b) {
+        if constexpr (std::is_floating_point<W>::value) {
+            return a + b;
+        } else {
+            if (a == infinity() || b == infinity()) return infinity();
+            if (b > 0 && a > infinity() - b) return infinity();
+            return a + b;
+        }
+    }
+};
+
+// Tipo das distâncias para pesos W: inteiros somam em 64 bits (com sinal se W tiver) e
+// ponto flutuante em double, então um caminho real não estoura nem colide com o infinito
+template <typename W>
+using DistanceOf = typename std::conditional<
+    std::is_floating_point<W>::value, double,
+    typename std::conditional<std::is_signed<W>::value, int64_t, uint64_t>::type>::type;
+
+// Distância não negativa convertida para um tipo mais estreito; o que não cabe vira infinito
+template <typename To, typename From>
+To narrowDistance(From d) {
+    return d < (From)WeightTraits<To>::infinity() ? (To)d : WeightTraits<To>::infinity();
+}
+
+// Índice reservado para "nenhum vértice" (substitui o -1 dos vetores de int)
+template <typename Index>
+constexpr Index noVertex() {
+    return std::numeric_limits<Index>::max();
+}
+
+template <typename W, typename Index = uint32_t>
+struct Edge {
+    Index from, to;
+    W weight;
+};
+
+// Grafo dirigido em formato CSR: os vizinhos de v ficam em [offsets[v], offsets[v+1])
+template <typename W, typename Index = uint32_t>
+struct Graph {
+    typedef W Weight;
+    typedef Index VertexId;
+
+    std::vector<size_t> offsets;
+    std::vector<Index> targets;
+    std::vector<W> weights;
+
+    Index numVertices() const { return offsets.empty() ? 0 : (Index)(offsets.size() - 1); }
+    size_t numEdges() const { return targets.size(); }
+    size_t memoryBytes() const { return offsets.size() * sizeof(size_t) + targets.size() * (sizeof(Index) + sizeof(W)); }
+
+    // f(destino, peso) para cada aresta que sai de v
+    template <typename F>
+    void forEachNeighbor(Index v, F f) const {
+        for (size_t e = offsets[v]; e < offsets[(size_t)v + 1]; ++e) f(targets[e], weights[e]);
+    }
+
+    // Monta o CSR a partir de uma lista de arestas (ordenação por contagem)
+    static Graph fromEdges(Index n, const std::vector<Edge<W, Index>>& edges) {
+        Graph g;
+        g.offsets.assign((size_t)n + 1, 0);
+        for (const auto& e : edges) g.offsets[(size_t)e.from + 1]++;
+        for (size_t v = 0; v < n; ++v) g.offsets[v + 1] += g.offsets[v];
+
+        g.targets.resize(edges.size());
+        g.weights.resize(edges.size());
+        std::vector<size_t> next(g.offsets.begin(), g.offsets.end() - 1);
+        for (const auto& e : edges) {
+            size_t slot = next[e.from]++;
+            g.targets[slot] = e.to;
+            g.weights[slot] = e.weight;
+        }
+        return g;
+    }
+
+    // Monta o CSR a partir da matriz de adjacência. noEdge marca a ausência de aresta
+    // (0 nas matrizes da interface); outro valor permite arestas de peso 0 ou negativo.
+    template <size_t N>
+    static Graph fromMatrix(const int matrix[][N], Index n, int noEdge = 0) {
+        std::vector<Edge<W, Index>> edges;
+        for (Index i = 0; i < n; ++i)
+            for (Index j = 0; j < n; ++j)
+                if (matrix[i][j] != noEdge) edges.push_back({ i, j, (W)matrix[i][j] });
+        return fromEdges(n, edges);
+    }
+};
+
+// Memória reaproveitável: aloca em blocos e devolve tudo de uma vez em reset().
+// Os blocos continuam reservados, então as próximas alocações não chamam new.
+class Arena {
+public:
+    explicit Arena(size_t blockSize = 1 << 16) : blockSize(blockSize) {}
+
+    template <typename T>
+    T* allocate(size_t count) {
+        static_assert(std::is_trivially_destructible<T>::value, "a arena não chama destrutores");
+        return static_cast<T*>(allocateBytes(count * sizeof(T), alignof(T)));
+    }
+
+    // Invalida tudo o que foi alocado; se a memória estava em vários blocos eles
+    // viram um só, do tamanho total, para a próxima rodada caber inteira nele
+    void reset() {
+        if (blocks.size() > 1) {
+            size_t total = reserved();
+            blocks.clear();
+            blocks.push_back({ std::unique_ptr<unsigned char[]>(new unsigned char[total]), total });
+        }
+        current = 0;
+        used = 0;
+    }
+
+    size_t reserved() const {
+        size_t total = 0;
+        for (const auto& b : blocks) total += b.size;
+        return total;
+    }
+
+private:
+    struct Block {
+        std::unique_ptr<unsigned char[]> data;
+        size_t size;
+    };
+
+    void* allocateBytes(size_t bytes, size_t align) {
+        for (; current < blocks.size(); ++current, used = 0) {
+            size_t offset = (used + align - 1) & ~(align - 1);
+            if (offset + bytes <= blocks[current].size) {
+                used = offset + bytes;
+                return blocks[current].data.get() + offset;
+            }
+        }
+        size_t size = std::max(blockSize, bytes);
+        blocks.push_back({ std::unique_ptr<unsigned char[]>(new unsigned char[size]), size });
+        used = bytes;
+        return blocks[current].data.get();
+    }
+
+    size_t blockSize;
+    std::vector<Block> blocks;
+    size_t current = 0; // bloco em uso
+    size_t used = 0;    // bytes ocupados no bloco em uso
+};
+
+// Estado de uma busca (distância, predecessor e origem de cada vértice) com
+// reinício preguiçoso: cada busca ganha uma época nova e uma entrada só é
+// reinicializada quando a busca a toca pela primeira vez. Começar uma busca custa
+// O(1), não O(V). D é o tipo da distância. Não é thread-safe: cada thread usa o seu
+// (ver DijkstraEngine).
+template <typename D, typename Index = uint32_t>
+class QueryWorkspace {
+public:
+    typedef WeightTraits<D> Traits;
+
+    // Prepara uma nova busca num grafo de n vértices (só aloca se n cresceu)
+    void begin(size_t n) {
+        if (n > capacity) grow(n);
+        if (++epoch == 0) { // a época deu a volta: zera os carimbos de verdade
+            std::fill(stamp, stamp + capacity, 0);
+            epoch = 1;
+        }
+    }
+
+    bool touched(Index v) const { return stamp[v] == epoch; }
+
+    void touch(Index v) {
+        if (stamp[v] == epoch) return;
+        stamp[v] = epoch;
+        dist[v] = Traits::infinity();
+        path[v] = noVertex<Index>();
+        origin[v] = noVertex<Index>();
+    }
+
+    // Leituras valem para qualquer vértice; os não tocados estão no estado inicial
+    D distance(Index v) const { return touched(v) ? dist[v] : Traits::infinity(); }
+    Index predecessor(Index v) const { return touched(v) ? path[v] : noVertex<Index>(); }
+    Index source(Index v) const { return touched(v) ? origin[v] : noVertex<Index>(); }
+
+    size_t reservedBytes() const { return arena.reserved(); }
+
+    // Acesso direto para o laço de relaxamento (só depois de touch(v))
+    D* dist = nullptr;
+    Index* path = nullptr;
+    Index* origin = nullptr;
+
+private:
+    void grow(size_t n) {
+        arena.reset();
+        dist = arena.allocate<D>(n);
+        path = arena.allocate<Index>(n);
+        origin = arena.allocate<Index>(n);
+        stamp = arena.allocate<uint32_t>(n);
+        std::fill(stamp, stamp + n, 0);
+        capacity = n;
+        epoch = 0;
+    }
+
+    Arena arena;
+    uint32_t* stamp = nullptr;
+    uint32_t epoch = 0;
+    size_t capacity = 0;
+};
+
+// Trabalho de uma busca. Contado em variáveis locais do laço e gravado no fim, então
+// fica sempre ligado: o custo é de alguns incrementos por aresta e duas leituras do relógio.
+struct SearchStats {
+    uint64_t settled = 0;        // vértices fixados
+    uint64_t relaxed = 0;        // arestas examinadas
+    uint64_t decreaseKeys = 0;   // distâncias já finitas que diminuíram (nova entrada no heap)
+    uint64_t heapPeak = 0;       // maior tamanho do heap, contando entradas obsoletas
+    uint64_t bytesAllocated = 0; // memória que o motor reservou durante a busca
+    uint64_t nanoseconds = 0;    // tempo de relógio da busca
+};
+
+// Dijkstra com heap binário. Buscas repetidas reaproveitam o mesmo workspace, então
+// uma busca local custa o que ela visita, não O(V). G é o CSR ou qualquer grafo com
+// numVertices() e forEachNeighbor(v, f) (ex.: CompressedGraph, grafoCompacto.h).
+// Pesos precisam ser não negativos; com negativos, reponderar antes (reponderacaoJohnson.h).
+// As distâncias ficam em D (por padrão DistanceOf<W>), inclusive no heap.
+template <typename W, typename Index = uint32_t, typename G = Graph<W, Index>, typename D = DistanceOf<W>>
+class DijkstraEngine {
+public:
+    typedef D Distance;
+    typedef WeightTraits<D> Traits;
+
+    explicit DijkstraEngine(const G& graph) : graph(&graph) {}
+
+    // Calcula a árvore de caminhos mínimos a partir de source. Para ao fixar target
+    // (quando informado); se stop() retornar true a busca é abandonada e devolve false.
+    template <typename Stop>
+    bool run(Index source, Index target, Stop stop) {
+        reset(false);
+        ws.touch(source);
+        ws.dist[source] = 0;
+        pushHeap({ 0, source });
+        return search([target](Index v) { return v == target; }, stop);
+    }
+
+    bool run(Index source, Index target = noVertex<Index>()) {
+        return run(source, target, [] { return false; });
+    }
+
+    // Uma origem e vários destinos: para quando todos estiverem fixados (ou a busca
+    // acabar). Destinos repetidos contam uma vez.
+    bool runToTargets(Index source, const Index* targets, size_t count) {
+        reset(false);
+        if (targetStamp.size() < graph->numVertices()) {
+            targetStamp.assign(graph->numVertices(), 0);
+            targetEpoch = 0;
+        }
+        if (++targetEpoch == 0) {
+            std::fill(targetStamp.begin(), targetStamp.end(), 0);
+            targetEpoch = 1;
+        }
+        size_t remaining = 0;
+        for (size_t i = 0; i < count; ++i)
+            if (targetStamp[targets[i]] != targetEpoch) {
+                targetStamp[targets[i]] = targetEpoch;
+                ++remaining;
+            }
+        ws.touch(source);
+        ws.dist[source] = 0;
+        pushHeap({ 0, source });
+        return search([this, &remaining](Index v) { return targetStamp[v] == targetEpoch && --remaining == 0; },
+                      [] { return false; });
+    }
+
+    // Várias origens numa única busca: cada origem começa com distância zero (ou com
+    // offsets[i], se informado) e nearestSource(v) diz qual delas é a mais próxima de v
+    template <typename Stop>
+    bool runMultiSource(const std::vector<Index>& sources, const std::vector<W>* offsets, Stop stop) {
+        reset(true);
+        for (size_t i = 0; i < sources.size(); ++i) {
+            Index s = sources[i];
+            D start = offsets ? (D)(*offsets)[i] : D(0);
+            ws.touch(s);
+            if (start < ws.dist[s]) {
+                ws.dist[s] = start;
+                ws.origin[s] = (Index)i;
+                pushHeap({ start, s });
+            }
+        }
+        return search([](Index) { return false; }, stop);
+    }
+
+    bool runMultiSource(const std::vector<Index>& sources, const std::vector<W>* offsets = nullptr) {
+        return runMultiSource(sources, offsets, [] { return false; });
+    }
+
+    bool reached(Index v) const { return ws.distance(v) != Traits::infinity(); }
+    D distance(Index v) const { return ws.distance(v); }
+
+    // Estatísticas da última busca
+    const SearchStats& stats() const { return lastStats; }
+    Index predecessor(Index v) const { return ws.predecessor(v); }
+
+    // Índice (na lista passada a runMultiSource) da origem mais próxima de v
+    Index nearestSource(Index v) const { return ws.source(v); }
+
+    // Caminho origem -> target seguindo os predecessores (vazio se inalcançável)
+    void buildPath(Index target, std::vector<Index>& out) const {
+        out.clear();
+        if (!reached(target)) return;
+        for (Index current = target; current != noVertex<Index>(); current = ws.predecessor(current))
+            out.push_back(current);
+        std::reverse(out.begin(), out.end());
+    }
+
+private:
+    // O(1): o workspace reinicia só o que a busca tocar e o heap mantém a capacidade
+    void reset(bool multiSource) {
+        started = std::chrono::steady_clock::now();
+        bytesBefore = reservedBytes();
+        ws.begin(graph->numVertices());
+        trackOwner = multiSource;
+        heap.clear();
+    }
+
+    size_t reservedBytes() const {
+        return ws.reservedBytes() + heap.capacity() * sizeof(HeapEntry) + targetStamp.capacity() * sizeof(uint32_t);
+    }
+
+    // done(v) é consultado a cada vértice fixado; true encerra a busca
+    template <typename Done, typename Stop>
+    bool search(Done done, Stop stop) {
+        uint64_t settled = 0, relaxed = 0, decreased = 0;
+        size_t peak = 0;
+        bool finished = true;
+        while (!heap.empty()) {
+            // O heap só cresce ao relaxar, então o pico aparece no início de alguma iteração
+            peak = std::max(peak, heap.size());
+            HeapEntry top = popHeap();
+            Index v = top.vertex;
+            if (top.dist != ws.dist[v]) continue; // entrada obsoleta
+            ++settled;
+            if (done(v)) break;
+            if ((settled & 255) == 0 && stop()) {
+                finished = false;
+                break;
+            }
+
+            graph->forEachNeighbor(v, [&](Index w, W weight) {
+                D candidate = Traits::add(top.dist, (D)weight);
+                ++relaxed;
+                ws.touch(w);
+                if (candidate < ws.dist[w]) {
+                    decreased += ws.dist[w] != Traits::infinity();
+                    ws.dist[w] = candidate;
+                    ws.path[w] = v;
+                    if (trackOwner) ws.origin[w] = ws.origin[v];
+                    pushHeap({ candidate, w });
+                }
+            });
+        }
+        lastStats.settled = settled;
+        lastStats.relaxed = relaxed;
+        lastStats.decreaseKeys = decreased;
+        lastStats.heapPeak = peak;
+        size_t bytesAfter = reservedBytes();
+        lastStats.bytesAllocated = bytesAfter > bytesBefore ? bytesAfter - bytesBefore : 0;
+        lastStats.nanoseconds = (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                    std::chrono::steady_clock::now() - started).count();
+        return finished;
+    }
+
+    struct HeapEntry {
+        D dist;
+        Index vertex;
+        bool operator>(const HeapEntry& other) const { return dist > other.dist; }
+    };
+
+    void pushHeap(const HeapEntry& entry) {
+        heap.push_back(entry);
+        std::push_heap(heap.begin(), heap.end(), std::greater<HeapEntry>());
+    }
+
+    HeapEntry popHeap() {
+        std::pop_heap(heap.begin(), heap.end(), std::greater<HeapEntry>());
+        HeapEntry top = heap.back();
+        heap.pop_back();
+        return top;
+    }
+
+    const G* graph;
+    QueryWorkspace<D, Index> ws; // um motor por thread, então o workspace também
+    bool trackOwner = false;     // propaga ws.origin (busca com várias origens)
+    std::vector<HeapEntry> heap;
+    std::vector<uint32_t> targetStamp; // destinos de runToTargets, marcados com a época
+    uint32_t targetEpoch = 0;
+    SearchStats lastStats;
+    std::chrono::steady_clock::time_point started; // início da busca atual (em reset)
+    size_t bytesBefore = 0;
+};
+
+#endif
@@ -0,0 +1,376 @@
+#ifndef CAPTURA_H
+#define CAPTURA_H
+
+// Captura de tela e de vídeo sem travar o pipeline. Cada quadro capturado é lido
+// com glReadPixels para um pixel buffer object (PBO) de um anel de CAPTURE_RING
+// buffers e marcado com um fence; o mapeamento só acontece quadros depois, quando o
+// fence já foi sinalizado, e a cópia vai para uma thread que grava os arquivos.
+// Formatos:
+//  - CAPTURE_PNG: sequência <prefixo>_<tomada>_<quadro>.png (PNG sem compressão, sem
+//    dependências); cada gravação é uma tomada
+//  - CAPTURE_RAW: vídeo RGB24 bruto <prefixo>_<segmento>_<largura>x<altura>.rgb; um
+//    segmento novo a cada gravação e a cada mudança de tamanho. Para converter:
+//      ffmpeg -f rawvideo -pixel_format rgb24 -video_size LxA -framerate 60 -i arquivo.rgb saida.mp4
+// Se o disco não acompanhar, quadros são descartados (e contados) em vez de atrasar a
+// aplicação.
+
+#include <GL/glew.h>
+#include <vector>
+#include <string>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
+#include <iostream>
+
+#define CAPTURE_RING 3        // PBOs em voo: a leitura de um quadro é mapeada 2 quadros depois
+#define CAPTURE_MAX_QUEUED 32 // quadros esperando a gravação antes de começar a descartar
+
+enum CaptureFormat { CAPTURE_PNG, CAPTURE_RAW };
+
+// PNG RGB de 8 bits com o deflate em blocos "stored" (sem compressão)
+class PngWriter {
+public:
+    static bool write(const std::string& fileName, const unsigned char* rgb, int width, int height) {
+        FILE* file = fopen(fileName.c_str(), "wb");
+        if (!file) {
+            std::cerr << "Erro: não foi possível criar " << fileName << std::endl;
+            return false;
+        }
+        static const unsigned char signature[8] = { 137, 'P', 'N', 'G', '\r', '\n', 26, '\n' };
+        fwrite(signature, 1, sizeof(signature), file);
+
+        unsigned char header[13];
+        put32(header, width);
+        put32(header + 4, height);
+        header[8] = 8;  // bits por canal
+        header[9] = 2;  // RGB
+        header[10] = header[11] = header[12] = 0;
+        chunk(file, "IHDR", header, sizeof(header));
+
+        // Cada linha: byte de filtro 0 + pixels. Blocos stored de até 65535 bytes.
+        size_t row = (size_t)width * 3 + 1;
+        std::vector<unsigned char> raw(row * height);
+        for (int y = 0; y < height; ++y) {
+            raw[y * row] = 0;
+            memcpy(&raw[y * row + 1], rgb + (size_t)y * width * 3, (size_t)width * 3);
+        }
+        std::vector<unsigned char> zlib;
+        zlib.reserve(raw.size() + raw.size() / 65535 * 5 + 16);
+        zlib.push_back(0x78);
+        zlib.push_back(0x01);
+        for (size_t offset = 0; offset < raw.size() || offset == 0; ) {
+            size_t length = std::min<size_t>(65535, raw.size() - offset);
+            bool last = offset + length == raw.size();
+            zlib.push_back(last ? 1 : 0);
+            zlib.push_back(length & 0xff);
+            zlib.push_back(length >> 8);
+            zlib.push_back(~length & 0xff);
+            zlib.push_back((~length >> 8) & 0xff);
+            zlib.insert(zlib.end(), raw.begin() + offset, raw.begin() + offset + length);
+            offset += length;
+            if (last) break;
+        }
+        unsigned char adler[4];
+        put32(adler, adler32(raw.data(), raw.size()));
+        zlib.insert(zlib.end(), adler, adler + 4);
+        chunk(file, "IDAT", zlib.data(), zlib.size());
+        chunk(file, "IEND", nullptr, 0);
+
+        bool ok = !ferror(file);
+        ok = fclose(file) == 0 && ok;
+        if (!ok) std::cerr << "Erro: falha ao gravar " << fileName << std::endl;
+        return ok;
+    }
+
+private:
+    static void put32(unsigned char* out, uint32_t value) {
+        out[0] = value >> 24;
+        out[1] = value >> 16;
+        out[2] = value >> 8;
+        out[3] = value;
+    }
+
+    static uint32_t crc32(uint32_t crc, const unsigned char* data, size_t size) {
+        static uint32_t table[256];
+        static bool ready = false;
+        if (!ready) {
+            for (uint32_t i = 0; i < 256; ++i) {
+                uint32_t c = i;
+                for (int k = 0; k < 8; ++k) c = c & 1 ? 0xedb88320u ^ (c >> 1) : c >> 1;
+                table[i] = c;
+            }
+            ready = true;
+        }
+        for (size_t i = 0; i < size; ++i) crc = table[(crc ^ data[i]) & 0xff] ^ (crc >> 8);
+        return crc;
+    }
+
+    static uint32_t adler32(const unsigned char* data, size_t size) {
+        uint32_t a = 1, b = 0;
+        while (size > 0) {
+            size_t block = std::min<size_t>(size, 5552); // sem estourar 32 bits antes do módulo
+            for (size_t i = 0; i < block; ++i) {
+                a += data[i];
+                b += a;
+            }
+            a %= 65521;
+            b %= 65521;
+            data += block;
+            size -= block;
+        }
+        return b << 16 | a;
+    }
+
+    static void chunk(FILE* file, const char type[4], const unsigned char* data, size_t size) {
+        unsigned char length[4], crc[4];
+        put32(length, (uint32_t)size);
+        fwrite(length, 1, 4, file);
+        fwrite(type, 1, 4, file);
+        if (size > 0) fwrite(data, 1, size, file);
+        uint32_t c = crc32(0xffffffffu, (const unsigned char*)type, 4);
+        put32(crc, crc32(c, data, size) ^ 0xffffffffu);
+        fwrite(crc, 1, 4, file);
+    }
+};
+
+class FrameCapture {
+public:
+    ~FrameCapture() { shutdown(); }
+
+    // Cria o anel de PBOs e a thread de gravação; chamado com o contexto GL ativo
+    void init(const std::string& filePrefix, CaptureFormat captureFormat) {
+        prefix = filePrefix;
+        format = captureFormat;
+        glGenBuffers(CAPTURE_RING, pbos);
+        running = true;
+        writer = std::thread(&FrameCapture::writeLoop, this);
+    }
+
+    // Libera a GL e espera a gravação do que já foi lido; chamado com o contexto ativo
+    void shutdown() {
+        if (!running) return;
+        recording = false;
+        screenshotPending = false;
+        drain();
+        glDeleteBuffers(CAPTURE_RING, pbos);
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            running = false;
+        }
+        cv.notify_one();
+        writer.join();
+        if (dropped > 0) std::cerr << "Aviso: " << dropped << " quadros de vídeo descartados (disco ou GPU lentos)" << std::endl;
+    }
+
+    bool isRecording() const { return recording; }
+
+    void toggleRecording() {
+        recording = !recording;
+        if (recording) {
+            videoFrame = 0;
+            ++take;
+            std::cout << "Gravando vídeo em " << prefix << (format == CAPTURE_PNG ? "_*.png" : "_*.rgb") << std::endl;
+        } else {
+            std::cout << "Vídeo encerrado" << std::endl;
+        }
+    }
+
+    void requestScreenshot() { screenshotPending = true; }
+
+    // Depois de desenhar o quadro e antes do swap: lê o back buffer para o próximo PBO
+    // (sem esperar a GPU) e entrega à gravação os quadros cujos fences já terminaram
+    void capture(int width, int height) {
+        collect(false);
+        if (!recording && !screenshotPending) return;
+
+        Slot& slot = slots[next];
+        if (slot.fence) collect(true); // anel cheio: a GPU está CAPTURE_RING quadros atrás
+        if (slot.fence) {
+            // Nem em 1 s a GPU terminou a leitura anterior deste PBO: pula o quadro em vez
+            // de reescrever o buffer (e perder o fence); uma captura de tela fica pendente
+            if (recording) ++dropped;
+            return;
+        }
+        size_t size = (size_t)width * height * 3;
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, pbos[next]);
+        if (slot.capacity < size) {
+            glBufferData(GL_PIXEL_PACK_BUFFER, size, nullptr, GL_STREAM_READ);
+            slot.capacity = size;
+        }
+        glPixelStorei(GL_PACK_ALIGNMENT, 1);
+        glReadPixels(0, 0, width, height, GL_RGB, GL_UNSIGNED_BYTE, nullptr);
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+        slot.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+        slot.width = width;
+        slot.height = height;
+        slot.video = recording;
+        slot.videoFrame = recording ? videoFrame++ : 0;
+        slot.take = take;
+        slot.screenshot = screenshotPending;
+        slot.order = issued++;
+        screenshotPending = false;
+        next = (next + 1) % CAPTURE_RING;
+    }
+
+private:
+    struct Slot {
+        GLsync fence = nullptr;
+        size_t capacity = 0;
+        int width = 0, height = 0;
+        bool video = false, screenshot = false;
+        int take = -1;
+        uint64_t videoFrame = 0, order = 0;
+    };
+
+    struct Frame {
+        std::vector<unsigned char> pixels; // de cima para baixo
+        int width, height;
+        bool video, screenshot;
+        int take; // gravação a que o quadro pertence
+        uint64_t videoFrame;
+    };
+
+    // Mapeia os PBOs prontos, na ordem em que foram lidos. Com wait, espera pelo mais
+    // antigo (anel cheio); sem wait, para no primeiro fence ainda não sinalizado.
+    void collect(bool wait) {
+        for (int i = 0; i < CAPTURE_RING; ++i) {
+            int s = oldestPending();
+            if (s < 0) return;
+            Slot& slot = slots[s];
+            GLenum status = glClientWaitSync(slot.fence, wait ? GL_SYNC_FLUSH_COMMANDS_BIT : 0,
+                                             wait ? 1000000000ull : 0);
+            if (status == GL_TIMEOUT_EXPIRED) return;
+            wait = false;
+            glDeleteSync(slot.fence);
+            slot.fence = nullptr;
+            if (status == GL_WAIT_FAILED) continue;
+
+            Frame frame;
+            frame.width = slot.width;
+            frame.height = slot.height;
+            frame.video = slot.video;
+            frame.screenshot = slot.screenshot;
+            frame.videoFrame = slot.videoFrame;
+            frame.take = slot.take;
+            if (slot.video && !slot.screenshot && queuedFrames() >= CAPTURE_MAX_QUEUED) {
+                ++dropped;
+                continue;
+            }
+            frame.pixels = takeBuffer();
+            size_t rowBytes = (size_t)slot.width * 3;
+            frame.pixels.resize(rowBytes * slot.height);
+            glBindBuffer(GL_PIXEL_PACK_BUFFER, pbos[s]);
+            const unsigned char* mapped = (const unsigned char*)glMapBufferRange(
+                GL_PIXEL_PACK_BUFFER, 0, rowBytes * slot.height, GL_MAP_READ_BIT);
+            if (mapped) {
+                for (int y = 0; y < slot.height; ++y) // a GL lê de baixo para cima
+                    memcpy(&frame.pixels[(size_t)(slot.height - 1 - y) * rowBytes], mapped + (size_t)y * rowBytes,
+                           rowBytes);
+                glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+            }
+            glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+            if (!mapped) continue;
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                queue.push_back(std::move(frame));
+            }
+            cv.notify_one();
+        }
+    }
+
+    void drain() {
+        while (oldestPending() >= 0) collect(true);
+    }
+
+    int oldestPending() const {
+        int oldest = -1;
+        for (int s = 0; s < CAPTURE_RING; ++s)
+            if (slots[s].fence && (oldest < 0 || slots[s].order < slots[oldest].order)) oldest = s;
+        return oldest;
+    }
+
+    size_t queuedFrames() {
+        std::lock_guard<std::mutex> lock(mutex);
+        return queue.size();
+    }
+
+    std::vector<unsigned char> takeBuffer() {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (pool.empty()) return std::vector<unsigned char>();
+        std::vector<unsigned char> buffer = std::move(pool.back());
+        pool.pop_back();
+        return buffer;
+    }
+
+    void writeLoop() {
+        FILE* video = nullptr;
+        int videoWidth = 0, videoHeight = 0, segment = 0, currentTake = -1, screenshot = 0;
+        while (true) {
+            Frame frame;
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                cv.wait(lock, [this] { return !queue.empty() || !running; });
+                if (queue.empty()) break;
+                frame = std::move(queue.front());
+                queue.pop_front();
+            }
+            // Primeiro quadro gravado de uma tomada (o quadro 0 pode ter sido descartado)
+            if (frame.video && frame.take != currentTake) {
+                currentTake = frame.take;
+                if (video) fclose(video);
+                video = nullptr;
+            }
+
+            char name[64];
+            if (frame.screenshot) {
+                snprintf(name, sizeof(name), "_tela_%03d.png", screenshot++);
+                if (PngWriter::write(prefix + name, frame.pixels.data(), frame.width, frame.height))
+                    std::cout << "Captura salva em " << prefix + name << std::endl;
+            }
+            if (frame.video && format == CAPTURE_PNG) {
+                snprintf(name, sizeof(name), "_%02d_%06llu.png", frame.take, (unsigned long long)frame.videoFrame);
+                PngWriter::write(prefix + name, frame.pixels.data(), frame.width, frame.height);
+            } else if (frame.video) {
+                if (video && (frame.width != videoWidth || frame.height != videoHeight)) { // janela redimensionada
+                    fclose(video);
+                    video = nullptr;
+                }
+                if (!video) {
+                    videoWidth = frame.width;
+                    videoHeight = frame.height;
+                    snprintf(name, sizeof(name), "_%d_%dx%d.rgb", segment++, videoWidth, videoHeight);
+                    video = fopen((prefix + name).c_str(), "wb");
+                    if (!video) std::cerr << "Erro: não foi possível criar " << prefix + name << std::endl;
+                }
+                if (video) fwrite(frame.pixels.data(), 1, frame.pixels.size(), video);
+            }
+
+            std::lock_guard<std::mutex> lock(mutex);
+            if (pool.size() < CAPTURE_RING + 2) pool.push_back(std::move(frame.pixels));
+        }
+        if (video) fclose(video);
+    }
+
+    std::string prefix;
+    CaptureFormat format = CAPTURE_PNG;
+    GLuint pbos[CAPTURE_RING];
+    Slot slots[CAPTURE_RING];
+    int next = 0;
+    uint64_t issued = 0, videoFrame = 0, dropped = 0;
+    int take = -1; // contador de gravações, incrementado em toggleRecording()
+    bool recording = false, screenshotPending = false;
+
+    std::thread writer;
+    std::mutex mutex; // protege queue, pool e running
+    std::condition_variable cv;
+    std::deque<Frame> queue;
+    std::vector<std::vector<unsigned char>> pool; // buffers já alocados, devolvidos pela gravação
+    bool running = false;
+};
+
+#endif
@@ -0,0 +1,160 @@
+#ifndef CONSULTAS_LOTE_H
+#define CONSULTAS_LOTE_H
+
+// Execução em lote de consultas (origem, destino) independentes sobre um grafo só de
+// leitura. Cada thread tem o próprio DijkstraEngine (workspace e heap), mantido entre
+// lotes. As consultas são agrupadas por origem: uma busca por origem, até fixar todos
+// os destinos dela, e os grupos são distribuídos entre as threads conforme elas ficam
+// livres. Os resultados voltam na ordem da entrada.
+
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <memory>
+#include <cstdint>
+#include <cstddef>
+#include <algorithm>
+#include "caminhoMinimo.h"
+
+// Distribui tasks tarefas entre até threads threads (a que chama é a 0): cada uma pega
+// a próxima tarefa livre de um contador atômico e chama work(thread, tarefa)
+template <typename F>
+void runTasks(unsigned threads, size_t tasks, F work) {
+    std::atomic<size_t> nextTask{ 0 };
+    auto loop = [&](unsigned t) {
+        for (size_t task; (task = nextTask.fetch_add(1, std::memory_order_relaxed)) < tasks;) work(t, task);
+    };
+    std::vector<std::thread> pool;
+    for (unsigned t = 1; t < std::min<size_t>(threads, std::max<size_t>(tasks, 1)); ++t) pool.emplace_back(loop, t);
+    loop(0);
+    for (auto& th : pool) th.join();
+}
+
+template <typename Index = uint32_t>
+struct BatchQuery {
+    Index source, target;
+};
+
+// Caminhos em formato CSR: o da consulta i é vertices[offsets[i], offsets[i + 1])
+template <typename Index = uint32_t>
+struct BatchPaths {
+    std::vector<size_t> offsets;
+    std::vector<Index> vertices;
+};
+
+template <typename W, typename Index = uint32_t>
+class BatchRunner {
+    static_assert(sizeof(Index) <= 4, "a ordenação por origem guarda origem e consulta em 64 bits");
+
+public:
+    typedef DistanceOf<W> Distance;
+
+    static constexpr size_t GROUPS_PER_TASK = 8; // grupos (origens) que uma thread pega de cada vez
+
+    explicit BatchRunner(const Graph<W, Index>& graph, unsigned threads = 0)
+        : graph(&graph), threads(threads ? threads : std::max(1u, std::thread::hardware_concurrency())) {
+        for (unsigned t = 0; t < this->threads; ++t) engines.emplace_back(new DijkstraEngine<W, Index>(graph));
+        pathParts.resize(this->threads);
+        groupTargets.resize(this->threads);
+    }
+
+    unsigned numThreads() const { return threads; }
+
+    // distances[i] recebe a distância da consulta i (infinito se inalcançável); com
+    // paths, também o caminho. Ids fora do grafo dão distância infinita. Até 2^32
+    // consultas por lote.
+    void run(const std::vector<BatchQuery<Index>>& queries, std::vector<Distance>& distances,
+             BatchPaths<Index>* paths = nullptr) {
+        size_t count = queries.size();
+        distances.assign(count, WeightTraits<Distance>::infinity());
+        groupBySource(queries);
+
+        std::vector<uint32_t> pathLength(paths ? count : 0, 0);
+        for (auto& part : pathParts) {
+            part.queries.clear();
+            part.vertices.clear();
+        }
+        size_t tasks = (groupStart.size() - 1 + GROUPS_PER_TASK - 1) / GROUPS_PER_TASK;
+
+        runTasks(threads, tasks, [&](unsigned t, size_t task) {
+            DijkstraEngine<W, Index>& engine = *engines[t];
+            PathPart& part = pathParts[t];
+            size_t lastGroup = std::min(groupStart.size() - 1, (task + 1) * GROUPS_PER_TASK);
+            for (size_t g = task * GROUPS_PER_TASK; g < lastGroup; ++g) {
+                size_t begin = groupStart[g], end = groupStart[g + 1];
+                Index source = queries[order[begin]].source;
+                if (end - begin == 1) engine.run(source, queries[order[begin]].target);
+                else engine.runToTargets(source, targetsOf(begin, end, queries, t), end - begin);
+                for (size_t k = begin; k < end; ++k) {
+                    size_t i = order[k];
+                    distances[i] = engine.distance(queries[i].target);
+                    if (!paths) continue;
+                    // Cada thread acumula os seus caminhos; a posição final sai depois
+                    engine.buildPath(queries[i].target, part.path);
+                    pathLength[i] = (uint32_t)part.path.size();
+                    part.queries.push_back(i);
+                    part.vertices.insert(part.vertices.end(), part.path.begin(), part.path.end());
+                }
+            }
+        });
+
+        if (paths) gatherPaths(pathLength, *paths);
+    }
+
+private:
+    // order = índices das consultas válidas ordenados por origem; groupStart marca o
+    // início de cada origem em order (com uma entrada extra no fim)
+    void groupBySource(const std::vector<BatchQuery<Index>>& queries) {
+        Index n = graph->numVertices();
+        std::vector<uint64_t> keyed;
+        keyed.reserve(queries.size());
+        for (size_t i = 0; i < queries.size(); ++i)
+            if (queries[i].source < n && queries[i].target < n) keyed.push_back((uint64_t)queries[i].source << 32 | i);
+        std::sort(keyed.begin(), keyed.end());
+        order.resize(keyed.size());
+        groupStart.clear();
+        for (size_t k = 0; k < keyed.size(); ++k) {
+            order[k] = (uint32_t)keyed[k];
+            if (k == 0 || keyed[k] >> 32 != keyed[k - 1] >> 32) groupStart.push_back(k);
+        }
+        groupStart.push_back(keyed.size());
+    }
+
+    // Destinos do grupo [begin, end) num vetor da thread t
+    const Index* targetsOf(size_t begin, size_t end, const std::vector<BatchQuery<Index>>& queries, unsigned t) {
+        std::vector<Index>& out = groupTargets[t];
+        out.clear();
+        for (size_t k = begin; k < end; ++k) out.push_back(queries[order[k]].target);
+        return out.data();
+    }
+
+    // Junta os caminhos das threads na ordem das consultas
+    void gatherPaths(const std::vector<uint32_t>& pathLength, BatchPaths<Index>& paths) {
+        paths.offsets.assign(pathLength.size() + 1, 0);
+        for (size_t i = 0; i < pathLength.size(); ++i) paths.offsets[i + 1] = paths.offsets[i] + pathLength[i];
+        paths.vertices.resize(paths.offsets.back());
+        for (const PathPart& part : pathParts) {
+            auto from = part.vertices.begin();
+            for (size_t i : part.queries) {
+                std::copy(from, from + pathLength[i], paths.vertices.begin() + paths.offsets[i]);
+                from += pathLength[i];
+            }
+        }
+    }
+
+    struct PathPart {
+        std::vector<size_t> queries; // consultas respondidas pela thread, em ordem
+        std::vector<Index> vertices; // os caminhos delas, um após o outro
+        std::vector<Index> path;     // caminho da consulta atual
+    };
+
+    const Graph<W, Index>* graph;
+    unsigned threads;
+    std::vector<std::unique_ptr<DijkstraEngine<W, Index>>> engines; // um por thread
+    std::vector<PathPart> pathParts;              // por thread
+    std::vector<std::vector<Index>> groupTargets; // por thread: destinos do grupo atual
+    std::vector<uint32_t> order;                  // consultas ordenadas por origem
+    std::vector<size_t> groupStart;
+};
+
+#endif
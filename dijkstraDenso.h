@@ -0,0 +1,228 @@
+#ifndef DIJKSTRA_DENSO_H
+#define DIJKSTRA_DENSO_H
+
+// Dijkstra O(V²) para grafos densos guardados em matriz de adjacência.
+// O estado dos vértices fica em estrutura de vetores (dist, key, path) e tanto a
+// busca do mínimo quanto o relaxamento da linha graph[v][*] são vetorizados.
+// O kernel (AVX-512, AVX2 ou escalar) é escolhido em tempo de execução.
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <climits>
+#include <algorithm>
+#include <immintrin.h>
+
+class DenseDijkstra {
+public:
+    enum Kernel { KERNEL_SCALAR, KERNEL_AVX2, KERNEL_AVX512 };
+
+    // Distâncias e pesos ficam abaixo de 2^30, então dist + peso nunca estoura um int32
+    static constexpr int32_t INF_DIST = 0x3FFFFFFF;
+    static constexpr int32_t SETTLED = INT32_MAX; // chave de vértice já fixado
+
+    explicit DenseDijkstra(int n)
+        : n(n), stride((n + 15) & ~15),
+          weights((size_t)stride * n, INF_DIST),
+          dist(stride), key(stride), path(stride) {}
+
+    // Monta a partir da matriz de adjacência (0 significa sem aresta)
+    template <size_t N>
+    static DenseDijkstra fromMatrix(const int matrix[][N], int n) {
+        DenseDijkstra d(n);
+        for (int i = 0; i < n; ++i)
+            for (int j = 0; j < n; ++j)
+                if (matrix[i][j] != 0) d.setEdge(i, j, matrix[i][j]);
+        return d;
+    }
+
+    void setEdge(int from, int to, int32_t weight) {
+        weights[(size_t)from * stride + to] = weight < INF_DIST ? weight : INF_DIST;
+    }
+
+    static Kernel bestKernel() {
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx512f")) return KERNEL_AVX512;
+        if (__builtin_cpu_supports("avx2")) return KERNEL_AVX2;
+        return KERNEL_SCALAR;
+    }
+
+    // Executa a partir de source; para ao fixar target (se >= 0) ou quando stop() for true
+    template <typename Stop>
+    bool run(int source, int target, Stop stop, Kernel kernel = bestKernel()) {
+        for (int i = 0; i < stride; ++i) {
+            dist[i] = INF_DIST;
+            key[i] = i < n ? INF_DIST : SETTLED;
+            path[i] = -1;
+        }
+        dist[source] = 0;
+        key[source] = 0;
+
+        for (int count = 0; count < n; ++count) {
+            int v;
+            switch (kernel) {
+                case KERNEL_AVX512: v = argminAvx512(); break;
+                case KERNEL_AVX2: v = argminAvx2(); break;
+                default: v = argminScalar(); break;
+            }
+            if (v == -1) break;
+
+            key[v] = SETTLED;
+            if (v == target) return true;
+            if ((count & 63) == 63 && stop()) return false;
+
+            const int32_t* row = &weights[(size_t)v * stride];
+            switch (kernel) {
+                case KERNEL_AVX512: relaxAvx512(v, row); break;
+                case KERNEL_AVX2: relaxAvx2(v, row); break;
+                default: relaxScalar(v, row); break;
+            }
+        }
+        return true;
+    }
+
+    bool run(int source, int target = -1, Kernel kernel = bestKernel()) {
+        return run(source, target, [] { return false; }, kernel);
+    }
+
+    int numVertices() const { return n; }
+    bool reached(int v) const { return dist[v] < INF_DIST; }
+    int32_t distance(int v) const { return dist[v]; }
+    int predecessor(int v) const { return path[v]; }
+
+    // Caminho origem -> target seguindo os predecessores (vazio se inalcançável)
+    void buildPath(int target, std::vector<int>& out) const {
+        out.clear();
+        if (!reached(target)) return;
+        for (int current = target; current != -1; current = path[current])
+            out.push_back(current);
+        std::reverse(out.begin(), out.end());
+    }
+
+private:
+    // Vértice não fixado de menor distância, ou -1 se só restam inalcançáveis
+    int argminScalar() const {
+        int32_t best = INF_DIST;
+        int index = -1;
+        for (int i = 0; i < n; ++i) {
+            if (key[i] < best) {
+                best = key[i];
+                index = i;
+            }
+        }
+        return index;
+    }
+
+    void relaxScalar(int v, const int32_t* row) {
+        int32_t dv = dist[v];
+        for (int w = 0; w < n; ++w) {
+            int32_t candidate = dv + row[w];
+            if (candidate < dist[w]) {
+                dist[w] = candidate;
+                key[w] = candidate;
+                path[w] = v;
+            }
+        }
+    }
+
+    __attribute__((target("avx2")))
+    int argminAvx2() const {
+        __m256i bestValue = _mm256_set1_epi32(INF_DIST);
+        __m256i bestIndex = _mm256_set1_epi32(-1);
+        __m256i index = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+        const __m256i step = _mm256_set1_epi32(8);
+
+        for (int i = 0; i < stride; i += 8) {
+            __m256i k = _mm256_loadu_si256((const __m256i*)&key[i]);
+            __m256i smaller = _mm256_cmpgt_epi32(bestValue, k);
+            bestValue = _mm256_min_epi32(bestValue, k);
+            bestIndex = _mm256_blendv_epi8(bestIndex, index, smaller);
+            index = _mm256_add_epi32(index, step);
+        }
+
+        alignas(32) int32_t values[8], indices[8];
+        _mm256_store_si256((__m256i*)values, bestValue);
+        _mm256_store_si256((__m256i*)indices, bestIndex);
+        return reduceLanes(values, indices, 8);
+    }
+
+    __attribute__((target("avx2")))
+    void relaxAvx2(int v, const int32_t* row) {
+        __m256i dv = _mm256_set1_epi32(dist[v]);
+        __m256i from = _mm256_set1_epi32(v);
+
+        for (int w = 0; w < stride; w += 8) {
+            __m256i candidate = _mm256_add_epi32(dv, _mm256_loadu_si256((const __m256i*)&row[w]));
+            __m256i current = _mm256_loadu_si256((const __m256i*)&dist[w]);
+            __m256i better = _mm256_cmpgt_epi32(current, candidate);
+            if (_mm256_testz_si256(better, better)) continue;
+
+            __m256i k = _mm256_loadu_si256((const __m256i*)&key[w]);
+            __m256i p = _mm256_loadu_si256((const __m256i*)&path[w]);
+            _mm256_storeu_si256((__m256i*)&dist[w], _mm256_blendv_epi8(current, candidate, better));
+            _mm256_storeu_si256((__m256i*)&key[w], _mm256_blendv_epi8(k, candidate, better));
+            _mm256_storeu_si256((__m256i*)&path[w], _mm256_blendv_epi8(p, from, better));
+        }
+    }
+
+    __attribute__((target("avx512f")))
+    int argminAvx512() const {
+        __m512i bestValue = _mm512_set1_epi32(INF_DIST);
+        __m512i bestIndex = _mm512_set1_epi32(-1);
+        __m512i index = _mm512_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+        const __m512i step = _mm512_set1_epi32(16);
+
+        for (int i = 0; i < stride; i += 16) {
+            __m512i k = _mm512_loadu_si512(&key[i]);
+            __mmask16 smaller = _mm512_cmplt_epi32_mask(k, bestValue);
+            bestValue = _mm512_mask_blend_epi32(smaller, bestValue, k);
+            bestIndex = _mm512_mask_blend_epi32(smaller, bestIndex, index);
+            index = _mm512_add_epi32(index, step);
+        }
+
+        alignas(64) int32_t values[16], indices[16];
+        _mm512_store_si512(values, bestValue);
+        _mm512_store_si512(indices, bestIndex);
+        return reduceLanes(values, indices, 16);
+    }
+
+    __attribute__((target("avx512f")))
+    void relaxAvx512(int v, const int32_t* row) {
+        __m512i dv = _mm512_set1_epi32(dist[v]);
+        __m512i from = _mm512_set1_epi32(v);
+
+        for (int w = 0; w < stride; w += 16) {
+            __m512i candidate = _mm512_add_epi32(dv, _mm512_loadu_si512(&row[w]));
+            __m512i current = _mm512_loadu_si512(&dist[w]);
+            __mmask16 better = _mm512_cmplt_epi32_mask(candidate, current);
+            if (!better) continue;
+
+            _mm512_mask_storeu_epi32(&dist[w], better, candidate);
+            _mm512_mask_storeu_epi32(&key[w], better, candidate);
+            _mm512_mask_storeu_epi32(&path[w], better, from);
+        }
+    }
+
+    // Combina os resultados das faixas: menor valor, e entre iguais o menor índice
+    static int reduceLanes(const int32_t* values, const int32_t* indices, int lanes) {
+        int32_t best = INF_DIST;
+        int index = -1;
+        for (int l = 0; l < lanes; ++l) {
+            if (values[l] >= INF_DIST) continue;
+            if (values[l] < best || (values[l] == best && indices[l] < index)) {
+                best = values[l];
+                index = indices[l];
+            }
+        }
+        return index;
+    }
+
+    int n;
+    int stride; // n arredondado para múltiplo de 16 (colunas extras têm peso infinito)
+    std::vector<int32_t> weights;
+    std::vector<int32_t> dist;
+    std::vector<int32_t> key;  // dist dos não fixados, SETTLED para os fixados
+    std::vector<int32_t> path;
+};
+
+#endif
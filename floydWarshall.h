@@ -0,0 +1,303 @@
+#ifndef FLOYD_WARSHALL_H
+#define FLOYD_WARSHALL_H
+
+// Distâncias entre todos os pares para grafos densos: Floyd–Warshall em blocos de
+// BLOCK x BLOCK. As matrizes ficam guardadas bloco a bloco (cada bloco contíguo, 16 KB),
+// para os blocos lidos no núcleo ficarem na L1 sem conflito de conjuntos, o que uma
+// linha de tamanho potência de 2 causaria. Cada rodada kb:
+//   1. fecha o bloco diagonal (kb, kb) com o Floyd–Warshall comum;
+//   2. atualiza a linha (kb, *) e a coluna (*, kb) de blocos com o diagonal fechado;
+//   3. atualiza os demais blocos: C = min(C, A(i, kb) + B(kb, j)) em min-plus.
+// As fases 2 e 3 dividem os blocos entre as threads, criadas uma vez por run() e
+// sincronizadas por uma barreira entre as fases. No núcleo, uma faixa da linha de
+// C fica em registradores enquanto k percorre o bloco (AVX-512, AVX2 ou escalar,
+// escolhido em tempo de execução como no DenseDijkstra). Somas com infinito não
+// estouram e nunca são menores que a distância atual, então não há desvio por elas.
+// Junto com as distâncias sai a matriz de próximos: next(i, j) é o vértice seguinte
+// a i no caminho mínimo até j, e o caminho é reconstruído em O(comprimento).
+
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+#include <algorithm>
+#include <immintrin.h>
+#include "dijkstraDenso.h"
+#include "barreiraFases.h"
+
+class FloydWarshall {
+public:
+    typedef DenseDijkstra::Kernel Kernel;
+
+    // Mesma convenção do DenseDijkstra: pesos e distâncias abaixo de 2^30, então a
+    // soma de duas distâncias (mesmo infinitas) cabe num int32
+    static constexpr int32_t INF_DIST = DenseDijkstra::INF_DIST;
+    static constexpr int BLOCK = 64;
+
+    explicit FloydWarshall(int n, bool withNextHop = true, unsigned threads = 0)
+        : n(n), blocks((n + BLOCK - 1) / BLOCK), withNext(withNextHop),
+          threads(threads ? threads : std::max(1u, std::thread::hardware_concurrency())),
+          dist((size_t)blocks * blocks * BLOCK * BLOCK, INF_DIST),
+          next(withNextHop ? dist.size() : 0, -1) {
+        for (int i = 0; i < blocks * BLOCK; ++i) {
+            dist[at(i, i)] = 0;
+            if (withNext) next[at(i, i)] = i;
+        }
+    }
+
+    // Monta a partir da matriz de adjacência (0 significa sem aresta)
+    template <size_t N>
+    static FloydWarshall fromMatrix(const int matrix[][N], int n, bool withNextHop = true) {
+        FloydWarshall fw(n, withNextHop);
+        for (int i = 0; i < n; ++i)
+            for (int j = 0; j < n; ++j)
+                if (matrix[i][j] != 0) fw.setEdge(i, j, matrix[i][j]);
+        return fw;
+    }
+
+    // Pesos não negativos; arestas paralelas ficam com o menor peso
+    void setEdge(int from, int to, int32_t weight) {
+        if (from == to) return;
+        size_t e = at(from, to);
+        weight = std::min(weight, INF_DIST);
+        if (weight >= dist[e]) return;
+        dist[e] = weight;
+        if (withNext) next[e] = to;
+    }
+
+    // Calcula todas as distâncias (uma vez, depois de todos os setEdge)
+    void run(Kernel kernel = DenseDijkstra::bestKernel()) {
+        int others = blocks - 1;
+        unsigned t = std::max(1u, std::min<unsigned>(threads, (unsigned)std::max(2 * others, others * others)));
+        PhaseBarrier barrier(t);
+        std::atomic<int> rowTask{ 0 }, restTask{ 0 };
+
+        // Todas as threads percorrem as rodadas juntas; a 0 fecha o diagonal e zera os
+        // contadores enquanto as outras esperam na barreira
+        auto work = [&](unsigned id) {
+            for (int kb = 0; kb < blocks; ++kb) {
+                if (id == 0) {
+                    closeDiagonal(kb);
+                    rowTask.store(0, std::memory_order_relaxed);
+                    restTask.store(0, std::memory_order_relaxed);
+                }
+                barrier.wait();
+                // Fase 2: blocos da linha e da coluna kb (2 * (blocks - 1) tarefas)
+                for (int task; (task = rowTask.fetch_add(1, std::memory_order_relaxed)) < 2 * others;) {
+                    int other = task / 2 < kb ? task / 2 : task / 2 + 1;
+                    if (task & 1) updateBlock(other, kb, other, kb, kb, kb, kernel); // coluna: C * diagonal
+                    else updateBlock(kb, other, kb, kb, kb, other, kernel);          // linha: diagonal * C
+                }
+                barrier.wait();
+                // Fase 3: os demais blocos, que só leem a linha e a coluna kb
+                for (int task; (task = restTask.fetch_add(1, std::memory_order_relaxed)) < others * others;) {
+                    int bi = task / others + (task / others >= kb), bj = task % others + (task % others >= kb);
+                    updateBlock(bi, bj, bi, kb, kb, bj, kernel);
+                }
+                barrier.wait(); // o próximo diagonal foi atualizado na fase 3
+            }
+        };
+        std::vector<std::thread> pool;
+        for (unsigned k = 1; k < t; ++k) pool.emplace_back(work, k);
+        work(0);
+        for (auto& th : pool) th.join();
+    }
+
+    int numVertices() const { return n; }
+    bool reached(int from, int to) const { return distance(from, to) < INF_DIST; }
+    int32_t distance(int from, int to) const { return dist[at(from, to)]; }
+    int nextHop(int from, int to) const { return next[at(from, to)]; }
+
+    // Caminho from -> to pela matriz de próximos (vazio se inalcançável ou sem next)
+    void buildPath(int from, int to, std::vector<int>& out) const {
+        out.clear();
+        if (!withNext || !reached(from, to)) return;
+        out.push_back(from);
+        for (int current = from; current != to;) {
+            current = nextHop(current, to);
+            out.push_back(current);
+        }
+    }
+
+private:
+    // Posição de (i, j): bloco (i / BLOCK, j / BLOCK) e, dentro dele, por linhas
+    size_t at(int i, int j) const {
+        return ((size_t)(i / BLOCK) * blocks + j / BLOCK) * BLOCK * BLOCK + (size_t)(i % BLOCK) * BLOCK + j % BLOCK;
+    }
+    size_t blockAt(int bi, int bj) const { return ((size_t)bi * blocks + bj) * BLOCK * BLOCK; }
+
+    // Floyd–Warshall comum dentro do bloco diagonal (k precisa ser o laço externo)
+    void closeDiagonal(int kb) {
+        size_t base = blockAt(kb, kb);
+        int32_t* d = &dist[base];
+        int32_t* nx = withNext ? &next[base] : nullptr;
+        for (int k = 0; k < BLOCK; ++k)
+            for (int i = 0; i < BLOCK; ++i) {
+                int32_t dik = d[(size_t)i * BLOCK + k];
+                if (dik >= INF_DIST) continue;
+                int32_t* row = d + (size_t)i * BLOCK;
+                const int32_t* through = d + (size_t)k * BLOCK;
+                for (int j = 0; j < BLOCK; ++j) {
+                    int32_t candidate = dik + through[j];
+                    if (candidate < row[j]) {
+                        row[j] = candidate;
+                        if (nx) nx[(size_t)i * BLOCK + j] = nx[(size_t)i * BLOCK + k];
+                    }
+                }
+            }
+    }
+
+    // C(ci, cj) = min(C, A(ai, aj) + B(bi, bj)); next de C vem de next de A. Quando C é
+    // também A ou B (fase 2), a outra matriz é o diagonal já fechado, então ler valores
+    // de C ainda não atualizados (ou já atualizados) dá o mesmo resultado.
+    void updateBlock(int ci, int cj, int ai, int aj, int bi, int bj, Kernel kernel) {
+        int32_t* c = &dist[blockAt(ci, cj)];
+        const int32_t* a = &dist[blockAt(ai, aj)];
+        const int32_t* b = &dist[blockAt(bi, bj)];
+        int32_t* cn = withNext ? &next[blockAt(ci, cj)] : nullptr;
+        const int32_t* an = withNext ? &next[blockAt(ai, aj)] : nullptr;
+        switch (kernel) {
+            case DenseDijkstra::KERNEL_AVX512:
+                if (withNext) blockAvx512<true>(c, cn, a, an, b);
+                else blockAvx512<false>(c, cn, a, an, b);
+                break;
+            case DenseDijkstra::KERNEL_AVX2:
+                if (withNext) blockAvx2<true>(c, cn, a, an, b);
+                else blockAvx2<false>(c, cn, a, an, b);
+                break;
+            default: blockScalar(c, cn, a, an, b); break;
+        }
+    }
+
+    void blockScalar(int32_t* c, int32_t* cn, const int32_t* a, const int32_t* an, const int32_t* b) const {
+        for (int i = 0; i < BLOCK; ++i) {
+            int32_t* row = c + (size_t)i * BLOCK;
+            for (int k = 0; k < BLOCK; ++k) {
+                int32_t aik = a[(size_t)i * BLOCK + k];
+                if (aik >= INF_DIST) continue;
+                const int32_t* through = b + (size_t)k * BLOCK;
+                for (int j = 0; j < BLOCK; ++j) {
+                    int32_t candidate = aik + through[j];
+                    if (candidate < row[j]) {
+                        row[j] = candidate;
+                        if (cn) cn[(size_t)i * BLOCK + j] = an[(size_t)i * BLOCK + k];
+                    }
+                }
+            }
+        }
+    }
+
+    // Uma linha de C (BLOCK = 64 colunas) em registradores: 4 vetores de distância e,
+    // com next, 4 de próximos
+    template <bool Next>
+    __attribute__((target("avx512f")))
+    void blockAvx512(int32_t* c, int32_t* cn, const int32_t* a, const int32_t* an, const int32_t* b) const {
+        for (int i = 0; i < BLOCK; ++i) {
+            int32_t* row = c + (size_t)i * BLOCK;
+            __m512i d0 = _mm512_loadu_si512(row), d1 = _mm512_loadu_si512(row + 16);
+            __m512i d2 = _mm512_loadu_si512(row + 32), d3 = _mm512_loadu_si512(row + 48);
+            __m512i n0, n1, n2, n3;
+            if (Next) {
+                int32_t* nrow = cn + (size_t)i * BLOCK;
+                n0 = _mm512_loadu_si512(nrow);
+                n1 = _mm512_loadu_si512(nrow + 16);
+                n2 = _mm512_loadu_si512(nrow + 32);
+                n3 = _mm512_loadu_si512(nrow + 48);
+            }
+            for (int k = 0; k < BLOCK; ++k) {
+                __m512i av = _mm512_set1_epi32(a[(size_t)i * BLOCK + k]);
+                const int32_t* through = b + (size_t)k * BLOCK;
+                __m512i c0 = _mm512_add_epi32(av, _mm512_loadu_si512(through));
+                __m512i c1 = _mm512_add_epi32(av, _mm512_loadu_si512(through + 16));
+                __m512i c2 = _mm512_add_epi32(av, _mm512_loadu_si512(through + 32));
+                __m512i c3 = _mm512_add_epi32(av, _mm512_loadu_si512(through + 48));
+                __mmask16 m0 = _mm512_cmplt_epi32_mask(c0, d0), m1 = _mm512_cmplt_epi32_mask(c1, d1);
+                __mmask16 m2 = _mm512_cmplt_epi32_mask(c2, d2), m3 = _mm512_cmplt_epi32_mask(c3, d3);
+                d0 = _mm512_mask_mov_epi32(d0, m0, c0);
+                d1 = _mm512_mask_mov_epi32(d1, m1, c1);
+                d2 = _mm512_mask_mov_epi32(d2, m2, c2);
+                d3 = _mm512_mask_mov_epi32(d3, m3, c3);
+                if (Next) {
+                    __m512i hop = _mm512_set1_epi32(an[(size_t)i * BLOCK + k]);
+                    n0 = _mm512_mask_mov_epi32(n0, m0, hop);
+                    n1 = _mm512_mask_mov_epi32(n1, m1, hop);
+                    n2 = _mm512_mask_mov_epi32(n2, m2, hop);
+                    n3 = _mm512_mask_mov_epi32(n3, m3, hop);
+                }
+            }
+            _mm512_storeu_si512(row, d0);
+            _mm512_storeu_si512(row + 16, d1);
+            _mm512_storeu_si512(row + 32, d2);
+            _mm512_storeu_si512(row + 48, d3);
+            if (Next) {
+                int32_t* nrow = cn + (size_t)i * BLOCK;
+                _mm512_storeu_si512(nrow, n0);
+                _mm512_storeu_si512(nrow + 16, n1);
+                _mm512_storeu_si512(nrow + 32, n2);
+                _mm512_storeu_si512(nrow + 48, n3);
+            }
+        }
+    }
+
+    // Com 16 registradores a linha é tratada em duas metades de 32 colunas
+    template <bool Next>
+    __attribute__((target("avx2")))
+    void blockAvx2(int32_t* c, int32_t* cn, const int32_t* a, const int32_t* an, const int32_t* b) const {
+        for (int i = 0; i < BLOCK; ++i)
+            for (int half = 0; half < BLOCK; half += 32) {
+                int32_t* row = c + (size_t)i * BLOCK + half;
+                __m256i d0 = _mm256_loadu_si256((const __m256i*)row);
+                __m256i d1 = _mm256_loadu_si256((const __m256i*)(row + 8));
+                __m256i d2 = _mm256_loadu_si256((const __m256i*)(row + 16));
+                __m256i d3 = _mm256_loadu_si256((const __m256i*)(row + 24));
+                __m256i n0 = d0, n1 = d1, n2 = d2, n3 = d3; // sem next não são usados
+                if (Next) {
+                    int32_t* nrow = cn + (size_t)i * BLOCK + half;
+                    n0 = _mm256_loadu_si256((const __m256i*)nrow);
+                    n1 = _mm256_loadu_si256((const __m256i*)(nrow + 8));
+                    n2 = _mm256_loadu_si256((const __m256i*)(nrow + 16));
+                    n3 = _mm256_loadu_si256((const __m256i*)(nrow + 24));
+                }
+                for (int k = 0; k < BLOCK; ++k) {
+                    __m256i av = _mm256_set1_epi32(a[(size_t)i * BLOCK + k]);
+                    const int32_t* through = b + (size_t)k * BLOCK + half;
+                    __m256i c0 = _mm256_add_epi32(av, _mm256_loadu_si256((const __m256i*)through));
+                    __m256i c1 = _mm256_add_epi32(av, _mm256_loadu_si256((const __m256i*)(through + 8)));
+                    __m256i c2 = _mm256_add_epi32(av, _mm256_loadu_si256((const __m256i*)(through + 16)));
+                    __m256i c3 = _mm256_add_epi32(av, _mm256_loadu_si256((const __m256i*)(through + 24)));
+                    if (Next) {
+                        __m256i hop = _mm256_set1_epi32(an[(size_t)i * BLOCK + k]);
+                        n0 = _mm256_blendv_epi8(n0, hop, _mm256_cmpgt_epi32(d0, c0));
+                        n1 = _mm256_blendv_epi8(n1, hop, _mm256_cmpgt_epi32(d1, c1));
+                        n2 = _mm256_blendv_epi8(n2, hop, _mm256_cmpgt_epi32(d2, c2));
+                        n3 = _mm256_blendv_epi8(n3, hop, _mm256_cmpgt_epi32(d3, c3));
+                    }
+                    d0 = _mm256_min_epi32(d0, c0);
+                    d1 = _mm256_min_epi32(d1, c1);
+                    d2 = _mm256_min_epi32(d2, c2);
+                    d3 = _mm256_min_epi32(d3, c3);
+                }
+                _mm256_storeu_si256((__m256i*)row, d0);
+                _mm256_storeu_si256((__m256i*)(row + 8), d1);
+                _mm256_storeu_si256((__m256i*)(row + 16), d2);
+                _mm256_storeu_si256((__m256i*)(row + 24), d3);
+                if (Next) {
+                    int32_t* nrow = cn + (size_t)i * BLOCK + half;
+                    _mm256_storeu_si256((__m256i*)nrow, n0);
+                    _mm256_storeu_si256((__m256i*)(nrow + 8), n1);
+                    _mm256_storeu_si256((__m256i*)(nrow + 16), n2);
+                    _mm256_storeu_si256((__m256i*)(nrow + 24), n3);
+                }
+            }
+    }
+
+    int n;
+    int blocks; // blocos por lado (vértices extras, até múltiplo de BLOCK, isolados)
+    bool withNext;
+    unsigned threads;
+    std::vector<int32_t> dist; // bloco a bloco, ver at()
+    std::vector<int32_t> next; // vértice seguinte no caminho, -1 se inalcançável
+};
+
+#endif
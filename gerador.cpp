@@ -0,0 +1,84 @@
+// Gerador de grafos sintéticos para testes de escala (motores e renderização).
+// Grava no formato texto (lido por trabalho.cpp) e/ou no snapshot binário
+// (lido por benchmark.cpp), ver arquivoGrafo.h.
+//
+// uso: ./gerador <grid|geometrico|rodovias|rmat|completo> <arestas> [opções]
+//   -s <semente>      (padrão 42)
+//   -p <euclidiano|uniforme|unitario>
+//   -w <peso máximo>  pesos uniformes em [1, w] (padrão 1000)
+//   -e <escala>       pesos euclidianos = distância * escala + 1 (padrão 1e6)
+//   -g <grau médio>   grafo geométrico (padrão 8)
+//   -j <deslocamento> grid/rodovias, em células (padrão 0.3)
+//   -o <prefixo>      arquivos de saída (padrão "grafo")
+//   -f <texto|snap|ambos> (padrão snap)
+
+#include <iostream>
+#include <string>
+#include <chrono>
+#include <cstdlib>
+#include "caminhoMinimo.h"
+#include "arquivoGrafo.h"
+#include "geradorGrafos.h"
+
+using namespace std;
+
+typedef uint32_t Weight;
+typedef uint32_t VertexId;
+
+void printUsage() {
+    cerr << "uso: gerador <grid|geometrico|rodovias|rmat|completo> <arestas> "
+            "[-s semente] [-p euclidiano|uniforme|unitario] [-w peso máximo] [-e escala] [-g grau médio] "
+            "[-j deslocamento] [-o prefixo] [-f texto|snap|ambos]" << endl;
+}
+
+int main(int argc, char** argv) {
+    if (argc < 3) {
+        printUsage();
+        return 1;
+    }
+    int family = parseFamily(argv[1]);
+    uint64_t targetEdges = strtoull(argv[2], nullptr, 10);
+    if (family < 0 || targetEdges == 0) {
+        printUsage();
+        return 1;
+    }
+
+    GeneratorOptions options;
+    string prefix = "grafo";
+    string format = "snap";
+    for (int i = 3; i + 1 < argc; i += 2) {
+        string flag = argv[i];
+        const char* value = argv[i + 1];
+        if (flag == "-s") options.seed = strtoull(value, nullptr, 10);
+        else if (flag == "-w") options.maxWeight = max(1, atoi(value));
+        else if (flag == "-e") options.euclideanScale = (float)atof(value);
+        else if (flag == "-g") options.averageDegree = (float)atof(value);
+        else if (flag == "-j") options.jitter = (float)atof(value);
+        else if (flag == "-o") prefix = value;
+        else if (flag == "-f") format = value;
+        else if (flag == "-p" && parseWeightModel(value) >= 0) options.weights = (WeightModel)parseWeightModel(value);
+        else {
+            cerr << "Erro: opção inválida " << flag << " " << value << endl;
+            printUsage();
+            return 1;
+        }
+    }
+    if ((argc - 3) % 2 != 0 || (format != "texto" && format != "snap" && format != "ambos")) {
+        printUsage();
+        return 1;
+    }
+
+    auto t0 = chrono::steady_clock::now();
+    Graph<Weight, VertexId> graph;
+    vector<Coordinate> positions;
+    GraphGenerator<Weight, VertexId>(options).generate((GraphFamily)family, targetEdges, graph, positions);
+    auto t1 = chrono::steady_clock::now();
+    cout << FAMILY_NAMES[family] << ": " << graph.numVertices() << " vértices, " << graph.numEdges()
+         << " arestas, pesos " << WEIGHT_NAMES[options.weights] << ", semente " << options.seed << " ("
+         << chrono::duration<double>(t1 - t0).count() << " s)" << endl;
+
+    bool ok = true;
+    if (format != "snap") ok = saveGraphText(prefix + ".txt", graph, positions) && ok;
+    if (format != "texto") ok = saveSnapshot(prefix + ".snap", graph, positions) && ok;
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,227 @@
+#ifndef GERADOR_GRAFOS_H
+#define GERADOR_GRAFOS_H
+
+// Geradores de grafos sintéticos reproduzíveis (mesma semente, mesmo grafo).
+// Todos produzem posições no quadrado [0, 1]² e arestas nos dois sentidos, exceto
+// o R-MAT, que é dirigido. A escala é dada pelo número aproximado de arestas.
+
+#include <cmath>
+#include <vector>
+#include <random>
+#include <string>
+#include <cstdint>
+#include <algorithm>
+#include "caminhoMinimo.h"
+#include "arquivoGrafo.h"
+
+enum GraphFamily { FAMILY_GRID, FAMILY_GEOMETRIC, FAMILY_ROAD, FAMILY_RMAT, FAMILY_COMPLETE, FAMILY_COUNT };
+enum WeightModel { WEIGHT_EUCLIDEAN, WEIGHT_UNIFORM, WEIGHT_UNIT };
+
+static const char* const FAMILY_NAMES[FAMILY_COUNT] = { "grid", "geometrico", "rodovias", "rmat", "completo" };
+static const char* const WEIGHT_NAMES[] = { "euclidiano", "uniforme", "unitario" };
+
+struct GeneratorOptions {
+    uint64_t seed = 42;
+    WeightModel weights = WEIGHT_EUCLIDEAN;
+    uint32_t maxWeight = 1000;     // WEIGHT_UNIFORM: pesos em [1, maxWeight]
+    float euclideanScale = 1e6f;   // WEIGHT_EUCLIDEAN: peso = distância * escala + 1
+    float jitter = 0.3f;           // grid/rodovias: deslocamento máximo, em células
+    float averageDegree = 8.0f;    // geométrico
+    uint32_t rmatEdgeFactor = 16;  // R-MAT: arestas por vértice
+};
+
+template <typename W = uint32_t, typename Index = uint32_t>
+class GraphGenerator {
+public:
+    explicit GraphGenerator(const GeneratorOptions& options) : options(options), rng(options.seed) {}
+
+    // Gera um grafo da família com aproximadamente targetEdges arestas
+    void generate(GraphFamily family, uint64_t targetEdges, Graph<W, Index>& graph, std::vector<Coordinate>& positions) {
+        edges.clear();
+        switch (family) {
+            case FAMILY_GRID: grid(sideFor(targetEdges / 4), positions, false); break;
+            case FAMILY_GEOMETRIC: geometric((Index)std::max<uint64_t>(2, targetEdges / options.averageDegree), positions); break;
+            case FAMILY_ROAD: grid(sideFor(targetEdges / 3), positions, true); break;
+            case FAMILY_RMAT: rmat(targetEdges, positions); break;
+            default: complete((Index)std::max<uint64_t>(2, (uint64_t)std::sqrt((double)targetEdges) + 1), positions); break;
+        }
+        graph = Graph<W, Index>::fromEdges((Index)positions.size(), edges);
+        std::vector<Edge<W, Index>>().swap(edges);
+    }
+
+private:
+    static Index sideFor(uint64_t vertices) { return (Index)std::max<uint64_t>(2, (uint64_t)std::sqrt((double)vertices)); }
+
+    // Sorteios próprios em vez das distribuições da biblioteca padrão, cuja saída
+    // muda entre implementações: a mesma semente dá o mesmo grafo em qualquer lugar
+    float unit() { return (float)(rng() >> 40) * (1.0f / (1u << 24)); }
+
+    template <typename T>
+    void shuffle(std::vector<T>& items) {
+        for (size_t i = items.size(); i > 1; --i) std::swap(items[i - 1], items[rng() % i]);
+    }
+
+    W weightFor(const std::vector<Coordinate>& positions, Index a, Index b, float factor = 1.0f) {
+        switch (options.weights) {
+            case WEIGHT_UNIT: return 1;
+            case WEIGHT_UNIFORM: return (W)(1 + rng() % options.maxWeight);
+            default: {
+                float dx = positions[a].x - positions[b].x, dy = positions[a].y - positions[b].y;
+                return (W)(std::sqrt(dx * dx + dy * dy) * factor * options.euclideanScale) + 1;
+            }
+        }
+    }
+
+    void addBoth(const std::vector<Coordinate>& positions, Index a, Index b, float factor = 1.0f) {
+        W w = weightFor(positions, a, b, factor);
+        edges.push_back({ a, b, w });
+        edges.push_back({ b, a, w });
+    }
+
+    // Grid side x side com posições deslocadas. Em modo rodovias: parte das ruas é
+    // removida (sem desconectar: uma árvore geradora aleatória é sempre mantida),
+    // algumas quadras ganham uma diagonal (uma só por quadra, então continua planar)
+    // e toda 16ª linha/coluna é uma via rápida com metade do custo por distância.
+    void grid(Index side, std::vector<Coordinate>& positions, bool road) {
+        size_t n = (size_t)side * side;
+        float cell = 1.0f / side;
+        positions.resize(n);
+        for (Index y = 0; y < side; ++y)
+            for (Index x = 0; x < side; ++x) {
+                float jx = (unit() * 2 - 1) * options.jitter, jy = (unit() * 2 - 1) * options.jitter;
+                positions[(size_t)y * side + x] = { (x + 0.5f + jx) * cell, (y + 0.5f + jy) * cell };
+            }
+
+        struct Street {
+            Index a, b;
+            bool highway;
+        };
+        std::vector<Street> streets;
+        streets.reserve(2 * n);
+        for (Index y = 0; y < side; ++y)
+            for (Index x = 0; x < side; ++x) {
+                Index v = y * side + x;
+                if (x + 1 < side) streets.push_back({ v, v + 1, road && y % 16 == 0 });
+                if (y + 1 < side) streets.push_back({ v, v + side, road && x % 16 == 0 });
+            }
+        if (!road) {
+            edges.reserve(2 * streets.size());
+            for (const Street& s : streets) addBoth(positions, s.a, s.b);
+            return;
+        }
+
+        // Árvore geradora (Kruskal em ordem aleatória) + 60% das demais ruas
+        shuffle(streets);
+        std::vector<Index> parent(n);
+        for (size_t v = 0; v < n; ++v) parent[v] = (Index)v;
+        auto find = [&](Index v) {
+            while (parent[v] != v) v = parent[v] = parent[parent[v]];
+            return v;
+        };
+        for (const Street& s : streets) {
+            Index ra = find(s.a), rb = find(s.b);
+            bool tree = ra != rb;
+            if (tree) parent[ra] = rb;
+            if (tree || s.highway || unit() < 0.6f) addBoth(positions, s.a, s.b, s.highway ? 0.5f : 1.0f);
+        }
+        for (Index y = 0; y + 1 < side; ++y)
+            for (Index x = 0; x + 1 < side; ++x)
+                if (unit() < 0.1f) {
+                    Index v = y * side + x;
+                    if (rng() & 1) addBoth(positions, v, v + side + 1);
+                    else addBoth(positions, v + 1, v + side);
+                }
+    }
+
+    // Geométrico aleatório: liga pares a distância <= r, com r escolhido para o grau médio
+    void geometric(Index n, std::vector<Coordinate>& positions) {
+        positions.resize(n);
+        for (auto& p : positions) p = { unit(), unit() };
+
+        float radius = std::sqrt(options.averageDegree / (float)(M_PI * n));
+        Index cells = (Index)std::max(1.0f, 1.0f / radius);
+        auto cellOf = [cells](float c) { return std::min(cells - 1, (Index)(c * cells)); };
+
+        // Vértices agrupados por célula (ordenação por contagem)
+        std::vector<size_t> start((size_t)cells * cells + 1, 0);
+        std::vector<Index> members(n);
+        for (Index v = 0; v < n; ++v) start[(size_t)cellOf(positions[v].y) * cells + cellOf(positions[v].x) + 1]++;
+        for (size_t c = 0; c + 1 < start.size(); ++c) start[c + 1] += start[c];
+        std::vector<size_t> fill(start.begin(), start.end() - 1);
+        for (Index v = 0; v < n; ++v) members[fill[(size_t)cellOf(positions[v].y) * cells + cellOf(positions[v].x)]++] = v;
+
+        edges.reserve((size_t)(n * options.averageDegree * 1.1f));
+        for (Index v = 0; v < n; ++v) {
+            Index cx = cellOf(positions[v].x), cy = cellOf(positions[v].y);
+            for (Index y = cy > 0 ? cy - 1 : 0; y <= std::min(cells - 1, cy + 1); ++y)
+                for (Index x = cx > 0 ? cx - 1 : 0; x <= std::min(cells - 1, cx + 1); ++x) {
+                    size_t c = (size_t)y * cells + x;
+                    for (size_t i = start[c]; i < start[c + 1]; ++i) {
+                        Index w = members[i];
+                        if (w <= v) continue; // cada par uma vez; addBoth cria os dois sentidos
+                        float dx = positions[v].x - positions[w].x, dy = positions[v].y - positions[w].y;
+                        if (dx * dx + dy * dy <= radius * radius) addBoth(positions, v, w);
+                    }
+                }
+        }
+    }
+
+    // R-MAT (Chakrabarti et al.) com a = 0.57, b = c = 0.19: grau com cauda pesada.
+    // Sem laços; arestas repetidas são mantidas (viram arestas paralelas).
+    void rmat(uint64_t targetEdges, std::vector<Coordinate>& positions) {
+        uint64_t vertices = std::max<uint64_t>(2, targetEdges / options.rmatEdgeFactor);
+        int scale = 1;
+        while ((1ull << scale) < vertices) ++scale;
+        Index n = (Index)(1ull << scale);
+
+        positions.resize(n);
+        for (auto& p : positions) p = { unit(), unit() };
+
+        edges.reserve(targetEdges);
+        while (edges.size() < targetEdges) {
+            Index from = 0, to = 0;
+            for (int bit = 0; bit < scale; ++bit) {
+                float r = unit();
+                if (r < 0.57f) continue;
+                if (r < 0.76f) to |= (Index)1 << bit;
+                else if (r < 0.95f) from |= (Index)1 << bit;
+                else {
+                    from |= (Index)1 << bit;
+                    to |= (Index)1 << bit;
+                }
+            }
+            if (from != to) edges.push_back({ from, to, weightFor(positions, from, to) });
+        }
+    }
+
+    // Completo: vértices num círculo, todas as arestas nos dois sentidos
+    void complete(Index n, std::vector<Coordinate>& positions) {
+        positions.resize(n);
+        for (Index v = 0; v < n; ++v) {
+            float angle = 2 * (float)M_PI * v / n;
+            positions[v] = { 0.5f + 0.45f * std::cos(angle), 0.5f + 0.45f * std::sin(angle) };
+        }
+        edges.reserve((size_t)n * (n - 1));
+        for (Index a = 0; a < n; ++a)
+            for (Index b = a + 1; b < n; ++b) addBoth(positions, a, b);
+    }
+
+    GeneratorOptions options;
+    std::mt19937_64 rng;
+    std::vector<Edge<W, Index>> edges;
+};
+
+// Converte nome (como em FAMILY_NAMES / WEIGHT_NAMES) para o enum; -1 se desconhecido
+inline int parseFamily(const std::string& name) {
+    for (int f = 0; f < FAMILY_COUNT; ++f)
+        if (name == FAMILY_NAMES[f]) return f;
+    return -1;
+}
+
+inline int parseWeightModel(const std::string& name) {
+    for (int w = WEIGHT_EUCLIDEAN; w <= WEIGHT_UNIT; ++w)
+        if (name == WEIGHT_NAMES[w]) return w;
+    return -1;
+}
+
+#endif
@@ -0,0 +1,279 @@
+#ifndef GERENCIADOR_SHADERS_H
+#define GERENCIADOR_SHADERS_H
+
+// Programas de shader com cache de binários em disco e compilação em paralelo.
+//  - Cache: depois de linkado, o binário do programa (glGetProgramBinary) é salvo em
+//    <diretório>/<nome>-<hash>.bin, com o hash calculado sobre fornecedor, renderer e
+//    versão do driver e sobre os fontes; na próxima execução glProgramBinary evita a
+//    compilação. Um binário recusado (driver atualizado) é recompilado e regravado.
+//  - Paralelo: startBuild() envia todas as compilações e links sem consultar status
+//    (com KHR/ARB_parallel_shader_compile o driver usa várias threads) e finishBuild()
+//    só espera depois que o chamador fez o resto da inicialização.
+//  - Recarga: com watch(dir), os fontes vêm de <dir>/<nome>.vert e <dir>/<nome>.frag
+//    (criados a partir dos embutidos se não existirem) e reloadChanged() recompila os
+//    programas cujos arquivos mudaram.
+
+#include <GL/glew.h>
+#include <vector>
+#include <string>
+#include <cmath>
+#include <chrono>
+#include <cstdio>
+#include <cstdint>
+#include <cstring>
+#include <utility>
+#include <iostream>
+#include <sys/stat.h>
+
+class ShaderManager {
+public:
+    explicit ShaderManager(const std::string& cacheDirectory) : cacheDir(cacheDirectory) {}
+
+    // Registra um programa; devolve o id usado em program()
+    int add(const std::string& name, const char* vertexSource, const char* fragmentSource) {
+        Entry e;
+        e.name = name;
+        e.sources[0] = vertexSource;
+        e.sources[1] = fragmentSource;
+        entries.push_back(e);
+        return (int)entries.size() - 1;
+    }
+
+    // Recarga durante o desenvolvimento: fontes lidos (e vigiados) em directory
+    void watch(const std::string& directory) {
+        watchDir = directory;
+        mkdir(directory.c_str(), 0755);
+        for (Entry& e : entries)
+            for (int s = 0; s < 2; ++s) {
+                std::string path = sourcePath(e, s);
+                if (!readFile(path, e.sources[s])) writeFile(path, e.sources[s].data(), e.sources[s].size());
+                e.modified[s] = modificationTime(path);
+            }
+    }
+
+    // Envia todas as compilações (ou carrega do cache) sem esperar o driver
+    void startBuild() {
+        buildStart = std::chrono::steady_clock::now();
+        if (GLEW_KHR_parallel_shader_compile) glMaxShaderCompilerThreadsKHR(0xffffffffu);
+        else if (GLEW_ARB_parallel_shader_compile) glMaxShaderCompilerThreadsARB(0xffffffffu);
+        useCache = GLEW_ARB_get_program_binary && !cacheDir.empty();
+        if (useCache) mkdir(cacheDir.c_str(), 0755);
+        std::string driver = driverId();
+        for (Entry& e : entries) {
+            e.key = hash(driver + '\0' + e.sources[0] + '\0' + e.sources[1]);
+            e.fromCache = useCache && loadBinary(e);
+            if (!e.fromCache) e.pending = beginCompile(e.sources[0], e.sources[1], e.shaders);
+        }
+    }
+
+    // Espera as compilações, confere erros e grava os binários novos no cache
+    bool finishBuild() {
+        bool ok = true;
+        cacheHits = 0;
+        for (Entry& e : entries) {
+            if (e.fromCache) {
+                e.program = e.pending = 0;
+                std::swap(e.program, e.cached);
+                ++cacheHits;
+                continue;
+            }
+            if (!endCompile(e.pending, e.shaders)) ok = false;
+            e.program = e.pending;
+            e.pending = 0;
+            if (useCache) saveBinary(e);
+        }
+        buildMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - buildStart).count();
+        return ok;
+    }
+
+    GLuint program(int id) const { return entries[id].program; }
+
+    // Recompila os programas cujos arquivos mudaram; um programa com erro mantém a
+    // versão anterior. Devolve true se algum programa foi trocado.
+    bool reloadChanged() {
+        if (watchDir.empty()) return false;
+        bool replaced = false;
+        for (Entry& e : entries) {
+            bool changed = false;
+            for (int s = 0; s < 2; ++s) {
+                long long modified = modificationTime(sourcePath(e, s));
+                if (modified != e.modified[s]) {
+                    e.modified[s] = modified;
+                    changed = readFile(sourcePath(e, s), e.sources[s]) || changed;
+                }
+            }
+            if (!changed) continue;
+            GLuint shaders[2];
+            GLuint program = beginCompile(e.sources[0], e.sources[1], shaders);
+            if (!endCompile(program, shaders)) {
+                std::cerr << "Shader " << e.name << " não recarregado (mantida a versão anterior)" << std::endl;
+                glDeleteProgram(program);
+                continue;
+            }
+            glDeleteProgram(e.program);
+            e.program = program;
+            replaced = true;
+            std::cout << "Shader " << e.name << " recarregado" << std::endl;
+        }
+        return replaced;
+    }
+
+    void printReport() const {
+        const char* mode = GLEW_KHR_parallel_shader_compile || GLEW_ARB_parallel_shader_compile ? "em paralelo" : "em série";
+        std::cout << "shaders: " << entries.size() << " programas em " << std::round(buildMs * 10) / 10 << " ms ("
+                  << cacheHits << " do cache, " << entries.size() - cacheHits << " compilados " << mode << ")"
+                  << std::endl;
+    }
+
+    void destroy() {
+        for (Entry& e : entries) {
+            glDeleteProgram(e.program);
+            e.program = 0;
+        }
+    }
+
+private:
+    struct Entry {
+        std::string name;
+        std::string sources[2]; // vértice, fragmento
+        uint64_t key = 0;
+        GLuint program = 0, pending = 0, cached = 0;
+        GLuint shaders[2] = { 0, 0 };
+        bool fromCache = false;
+        long long modified[2] = { 0, 0 };
+    };
+
+    static uint64_t hash(const std::string& text) { // FNV-1a
+        uint64_t h = 1469598103934665603ull;
+        for (unsigned char c : text) h = (h ^ c) * 1099511628211ull;
+        return h;
+    }
+
+    static std::string driverId() {
+        std::string id;
+        for (GLenum name : { GL_VENDOR, GL_RENDERER, GL_VERSION }) {
+            const GLubyte* value = glGetString(name);
+            id += value ? (const char*)value : "?";
+            id += '\n';
+        }
+        return id;
+    }
+
+    std::string cachePath(const Entry& e) const {
+        char key[17];
+        snprintf(key, sizeof(key), "%016llx", (unsigned long long)e.key);
+        return cacheDir + "/" + e.name + "-" + key + ".bin";
+    }
+
+    std::string sourcePath(const Entry& e, int stage) const {
+        return watchDir + "/" + e.name + (stage == 0 ? ".vert" : ".frag");
+    }
+
+    static long long modificationTime(const std::string& path) {
+        struct stat info;
+        if (stat(path.c_str(), &info) != 0) return 0;
+        return (long long)info.st_mtim.tv_sec * 1000000000ll + info.st_mtim.tv_nsec;
+    }
+
+    static bool readFile(const std::string& path, std::string& out) {
+        FILE* file = fopen(path.c_str(), "rb");
+        if (!file) return false;
+        std::string text;
+        char buffer[4096];
+        size_t n;
+        while ((n = fread(buffer, 1, sizeof(buffer), file)) > 0) text.append(buffer, n);
+        fclose(file);
+        out.swap(text);
+        return true;
+    }
+
+    static bool writeFile(const std::string& path, const void* data, size_t size) {
+        FILE* file = fopen(path.c_str(), "wb");
+        if (!file) return false;
+        bool ok = fwrite(data, 1, size, file) == size;
+        return fclose(file) == 0 && ok;
+    }
+
+    // Arquivo do cache: formato do binário (GLenum) seguido do binário
+    bool loadBinary(Entry& e) {
+        std::string data;
+        if (!readFile(cachePath(e), data) || data.size() <= sizeof(GLenum)) return false;
+        GLenum format;
+        memcpy(&format, data.data(), sizeof(format));
+        GLuint program = glCreateProgram();
+        glProgramBinary(program, format, data.data() + sizeof(format), (GLsizei)(data.size() - sizeof(format)));
+        GLint linked = GL_FALSE;
+        glGetProgramiv(program, GL_LINK_STATUS, &linked);
+        if (!linked) { // driver mudou sem mudar o hash, ou arquivo corrompido
+            glDeleteProgram(program);
+            return false;
+        }
+        e.cached = program;
+        return true;
+    }
+
+    void saveBinary(const Entry& e) const {
+        GLint length = 0;
+        glGetProgramiv(e.program, GL_PROGRAM_BINARY_LENGTH, &length);
+        if (length <= 0) return;
+        std::vector<char> data(sizeof(GLenum) + length);
+        GLenum format = 0;
+        glGetProgramBinary(e.program, length, nullptr, &format, data.data() + sizeof(GLenum));
+        memcpy(data.data(), &format, sizeof(format));
+        if (!writeFile(cachePath(e), data.data(), data.size()))
+            std::cerr << "Aviso: não foi possível gravar o cache de shaders em " << cachePath(e) << std::endl;
+    }
+
+    static GLuint beginCompile(const std::string& vertexSource, const std::string& fragmentSource, GLuint shaders[2]) {
+        const GLenum types[2] = { GL_VERTEX_SHADER, GL_FRAGMENT_SHADER };
+        const std::string* sources[2] = { &vertexSource, &fragmentSource };
+        GLuint program = glCreateProgram();
+        for (int s = 0; s < 2; ++s) {
+            const char* text = sources[s]->c_str();
+            shaders[s] = glCreateShader(types[s]);
+            glShaderSource(shaders[s], 1, &text, NULL);
+            glCompileShader(shaders[s]);
+            glAttachShader(program, shaders[s]);
+        }
+        glProgramParameteri(program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+        glLinkProgram(program);
+        return program;
+    }
+
+    // Primeira consulta de status: aqui o driver termina a compilação, se ainda não terminou
+    static bool endCompile(GLuint program, GLuint shaders[2]) {
+        bool ok = true;
+        for (int s = 0; s < 2; ++s) {
+            GLint success;
+            glGetShaderiv(shaders[s], GL_COMPILE_STATUS, &success);
+            if (!success) {
+                char infoLog[512];
+                glGetShaderInfoLog(shaders[s], 512, NULL, infoLog);
+                std::cerr << "Erro de compilação do shader:\n" << infoLog << std::endl;
+                ok = false;
+            }
+        }
+        GLint success;
+        glGetProgramiv(program, GL_LINK_STATUS, &success);
+        if (!success) {
+            char infoLog[512];
+            glGetProgramInfoLog(program, 512, NULL, infoLog);
+            std::cerr << "Erro de linkagem do shader program:\n" << infoLog << std::endl;
+            ok = false;
+        }
+        for (int s = 0; s < 2; ++s) {
+            glDetachShader(program, shaders[s]);
+            glDeleteShader(shaders[s]);
+        }
+        return ok;
+    }
+
+    std::string cacheDir, watchDir;
+    std::vector<Entry> entries;
+    bool useCache = false;
+    int cacheHits = 0;
+    double buildMs = 0.0;
+    std::chrono::steady_clock::time_point buildStart;
+};
+
+#endif
@@ -0,0 +1,215 @@
+#ifndef GRAFO_COMPACTO_H
+#define GRAFO_COMPACTO_H
+
+// Grafo comprimido, só de leitura, para grafos que mal cabem na memória em CSR.
+// Cada vértice vira um bloco de bytes:
+//   varint(grau * 64 + largura)   largura em bits dos pesos do vértice (0 a 32)
+//   varint zigzag(1º destino - v)
+//   varint(menor peso)
+//   pesos - menor peso, `largura` bits cada, empacotados (ceil(grau * largura / 8) bytes)
+//   diferenças entre destinos consecutivos (ordenados) em group-varint: um byte de
+//   controle com o tamanho (1 a 4 bytes) de 4 valores, seguido deles; o resto (< 4) em varint
+// Com vértices numa ordem com localidade (Hilbert, RCM) as diferenças cabem em 1 ou
+// 2 bytes. A decodificação acontece dentro do laço de relaxação (forEachNeighbor),
+// 4 destinos por vez; com SSSE3 cada grupo sai com um pshufb e uma soma de prefixos.
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <algorithm>
+#include <type_traits>
+#include "caminhoMinimo.h"
+#ifdef __SSSE3__
+#include <immintrin.h>
+#endif
+
+// Tabelas do group-varint indexadas pelo byte de controle
+struct GroupVarintTables {
+    uint8_t length[256];      // bytes de dados do grupo
+    uint8_t shuffle[256][16]; // máscara do pshufb: byte de dados -> posição no uint32
+
+    GroupVarintTables() {
+        for (int control = 0; control < 256; ++control) {
+            int pos = 0;
+            for (int k = 0; k < 4; ++k) {
+                int size = ((control >> (2 * k)) & 3) + 1;
+                for (int b = 0; b < 4; ++b) shuffle[control][4 * k + b] = b < size ? (uint8_t)(pos + b) : 0x80;
+                pos += size;
+            }
+            length[control] = (uint8_t)pos;
+        }
+    }
+};
+
+inline const GroupVarintTables groupVarintTables;
+
+template <typename W, typename Index = uint32_t>
+class CompressedGraph {
+    static_assert(std::is_integral<W>::value && std::is_unsigned<W>::value && sizeof(W) <= 4,
+                  "pesos comprimidos precisam ser inteiros sem sinal de até 32 bits");
+    static_assert(sizeof(Index) <= 4, "destinos comprimidos em até 32 bits");
+
+public:
+    typedef W Weight;
+    typedef Index VertexId;
+
+    static constexpr int CHUNK_BITS = 10; // um deslocamento de 64 bits a cada 1024 vértices
+    static constexpr size_t PADDING = 16; // leituras de 16 bytes no fim do buffer
+
+    static CompressedGraph fromGraph(const Graph<W, Index>& g) {
+        CompressedGraph c;
+        c.n = g.numVertices();
+        c.m = g.numEdges();
+        c.start.resize(c.n);
+        c.chunkBase.resize(((size_t)c.n >> CHUNK_BITS) + 1);
+        std::vector<std::pair<Index, W>> edges;
+        std::vector<uint8_t>& out = c.data;
+        out.reserve(g.numEdges() * 3);
+
+        for (Index v = 0; v < c.n; ++v) {
+            if ((v & ((1u << CHUNK_BITS) - 1)) == 0) c.chunkBase[v >> CHUNK_BITS] = out.size();
+            c.start[v] = (uint32_t)(out.size() - c.chunkBase[v >> CHUNK_BITS]);
+
+            edges.clear();
+            for (size_t e = g.offsets[v]; e < g.offsets[(size_t)v + 1]; ++e) edges.push_back({ g.targets[e], g.weights[e] });
+            std::sort(edges.begin(), edges.end());
+            size_t degree = edges.size();
+            W low = 0, high = 0;
+            if (degree > 0) {
+                low = high = edges[0].second;
+                for (const auto& e : edges) {
+                    low = std::min(low, e.second);
+                    high = std::max(high, e.second);
+                }
+            }
+            int width = high > low ? 32 - __builtin_clz((uint32_t)(high - low)) : 0;
+            putVarint(out, (uint64_t)degree * 64 + width);
+            if (degree == 0) continue;
+            int64_t first = (int64_t)edges[0].first - (int64_t)v;
+            putVarint(out, ((uint64_t)first << 1) ^ (uint64_t)(first >> 63)); // zigzag sem deslocar negativo
+            putVarint(out, low);
+
+            // Pesos empacotados em ordem crescente de bits
+            size_t weightBase = out.size();
+            out.resize(weightBase + (degree * width + 7) / 8, 0);
+            for (size_t i = 0; i < degree; ++i) {
+                uint64_t value = edges[i].second - low;
+                for (size_t bit = i * width, k = 0; k < (size_t)width; ++k, ++bit)
+                    if (value >> k & 1) out[weightBase + bit / 8] |= (uint8_t)(1u << (bit % 8));
+            }
+
+            size_t i = 1;
+            for (; i + 4 <= degree; i += 4) {
+                size_t control = out.size();
+                out.push_back(0);
+                for (int k = 0; k < 4; ++k) {
+                    uint32_t gap = (uint32_t)(edges[i + k].first - edges[i + k - 1].first);
+                    int size = gap < (1u << 8) ? 1 : gap < (1u << 16) ? 2 : gap < (1u << 24) ? 3 : 4;
+                    out[control] |= (uint8_t)((size - 1) << (2 * k));
+                    for (int b = 0; b < size; ++b) out.push_back((uint8_t)(gap >> (8 * b)));
+                }
+            }
+            for (; i < degree; ++i) putVarint(out, edges[i].first - edges[i - 1].first);
+        }
+        out.resize(out.size() + PADDING, 0);
+        out.shrink_to_fit();
+        return c;
+    }
+
+    Index numVertices() const { return n; }
+    size_t numEdges() const { return m; }
+    size_t memoryBytes() const {
+        return data.size() + start.size() * sizeof(uint32_t) + chunkBase.size() * sizeof(uint64_t);
+    }
+
+    size_t degree(Index v) const {
+        const uint8_t* p = block(v);
+        return (size_t)(getVarint(p) >> 6);
+    }
+
+    // f(destino, peso) para cada aresta que sai de v, em ordem crescente de destino
+    template <typename F>
+    void forEachNeighbor(Index v, F f) const {
+        const uint8_t* p = block(v);
+        uint64_t header = getVarint(p);
+        size_t degree = (size_t)(header >> 6);
+        if (degree == 0) return;
+        int width = (int)(header & 63);
+        uint64_t zig = getVarint(p);
+        uint32_t target = (uint32_t)((int64_t)v + (int64_t)((zig >> 1) ^ (~(zig & 1) + 1)));
+        W low = (W)getVarint(p);
+        const uint8_t* weights = p;
+        p += (degree * width + 7) / 8;
+        uint64_t mask = ((uint64_t)1 << width) - 1;
+        auto weightAt = [&](size_t i) {
+            size_t bit = i * width;
+            uint64_t word;
+            std::memcpy(&word, weights + bit / 8, sizeof(word));
+            return (W)(low + ((word >> (bit % 8)) & mask));
+        };
+
+        f((Index)target, weightAt(0));
+        size_t i = 1;
+        uint32_t group[4];
+        for (; i + 4 <= degree; i += 4) {
+            p = decodeGroup(p, target, group);
+            target = group[3];
+            for (int k = 0; k < 4; ++k) f((Index)group[k], weightAt(i + k));
+        }
+        for (; i < degree; ++i) {
+            target += (uint32_t)getVarint(p);
+            f((Index)target, weightAt(i));
+        }
+    }
+
+private:
+    const uint8_t* block(Index v) const {
+        return data.data() + chunkBase[v >> CHUNK_BITS] + start[v];
+    }
+
+    static void putVarint(std::vector<uint8_t>& out, uint64_t value) {
+        while (value >= 0x80) {
+            out.push_back((uint8_t)(value | 0x80));
+            value >>= 7;
+        }
+        out.push_back((uint8_t)value);
+    }
+
+    static uint64_t getVarint(const uint8_t*& p) {
+        uint64_t value = *p & 0x7F;
+        for (int shift = 7; *p++ & 0x80; shift += 7) value |= (uint64_t)(*p & 0x7F) << shift;
+        return value;
+    }
+
+    // Quatro diferenças de um grupo, acumuladas a partir de base
+    static const uint8_t* decodeGroup(const uint8_t* p, uint32_t base, uint32_t out[4]) {
+        uint8_t control = *p++;
+#ifdef __SSSE3__
+        __m128i bytes = _mm_loadu_si128((const __m128i*)p);
+        __m128i gaps = _mm_shuffle_epi8(bytes, _mm_loadu_si128((const __m128i*)groupVarintTables.shuffle[control]));
+        gaps = _mm_add_epi32(gaps, _mm_slli_si128(gaps, 4));
+        gaps = _mm_add_epi32(gaps, _mm_slli_si128(gaps, 8));
+        _mm_storeu_si128((__m128i*)out, _mm_add_epi32(gaps, _mm_set1_epi32((int)base)));
+#else
+        const uint8_t* q = p;
+        for (int k = 0; k < 4; ++k) {
+            int size = ((control >> (2 * k)) & 3) + 1;
+            uint32_t word;
+            std::memcpy(&word, q, sizeof(word));
+            base += size == 4 ? word : word & ((1u << (8 * size)) - 1);
+            out[k] = base;
+            q += size;
+        }
+#endif
+        return p + groupVarintTables.length[control];
+    }
+
+    Index n = 0;
+    size_t m = 0;
+    std::vector<uint64_t> chunkBase; // início de cada bloco de 1024 vértices em data
+    std::vector<uint32_t> start;     // início de cada vértice, relativo ao seu bloco
+    std::vector<uint8_t> data;
+};
+
+#endif
@@ -0,0 +1,185 @@
+#ifndef GRAVACAO_ENTRADA_H
+#define GRAVACAO_ENTRADA_H
+
+// Gravação e reprodução de entradas (teclado, mouse, redimensionamento) e registro
+// de tempos por quadro, para comparar versões sobre a mesma sequência de interação.
+// Formato da gravação, uma entrada por linha, tempo em segundos desde o início:
+//     # gravacao <largura> <altura>
+//     <tempo> K <tecla> <scancode> <ação> <modificadores>
+//     <tempo> B <botão> <ação> <modificadores>
+//     <tempo> C <x> <y>
+//     <tempo> S <largura> <altura>
+//     <tempo> E                        (fim da gravação)
+
+#include <vector>
+#include <string>
+#include <cstdio>
+#include <cstring>
+#include <algorithm>
+#include <iostream>
+
+enum InputEventType {
+    INPUT_KEY = 'K',
+    INPUT_MOUSE_BUTTON = 'B',
+    INPUT_CURSOR = 'C',
+    INPUT_RESIZE = 'S',
+    INPUT_END = 'E',
+};
+
+struct InputEvent {
+    double time;
+    char type;
+    int a, b, c, d;   // K: tecla, scancode, ação, mods; B: botão, ação, mods; S: largura, altura
+    double x, y;      // C: posição do cursor
+};
+
+class InputRecorder {
+public:
+    ~InputRecorder() {
+        if (file) fclose(file); // sem a marca de fim: a reprodução recusa o arquivo
+    }
+
+    bool open(const std::string& fileName, int width, int height) {
+        file = fopen(fileName.c_str(), "w");
+        if (!file) {
+            std::cerr << "Erro: não foi possível criar a gravação " << fileName << std::endl;
+            return false;
+        }
+        fprintf(file, "# gravacao %d %d\n", width, height);
+        return true;
+    }
+
+    bool active() const { return file != nullptr; }
+
+    void record(const InputEvent& e) {
+        if (!file) return;
+        switch (e.type) {
+            case INPUT_KEY: fprintf(file, "%.6f K %d %d %d %d\n", e.time, e.a, e.b, e.c, e.d); break;
+            case INPUT_MOUSE_BUTTON: fprintf(file, "%.6f B %d %d %d\n", e.time, e.a, e.b, e.c); break;
+            case INPUT_CURSOR: fprintf(file, "%.6f C %.17g %.17g\n", e.time, e.x, e.y); break;
+            case INPUT_RESIZE: fprintf(file, "%.6f S %d %d\n", e.time, e.a, e.b); break;
+        }
+    }
+
+    // Marca o fim (a reprodução dura até esse instante) e fecha o arquivo
+    void close(double time) {
+        if (!file) return;
+        fprintf(file, "%.6f E\n", time);
+        fclose(file);
+        file = nullptr;
+    }
+
+private:
+    FILE* file = nullptr;
+};
+
+class InputTrace {
+public:
+    bool load(const std::string& fileName) {
+        FILE* file = fopen(fileName.c_str(), "r");
+        if (!file) {
+            std::cerr << "Erro: não foi possível abrir a gravação " << fileName << std::endl;
+            return false;
+        }
+        events.clear();
+        next = 0;
+        char line[256];
+        bool ok = true, ended = false;
+        while (ok && fgets(line, sizeof(line), file)) {
+            if (sscanf(line, "# gravacao %d %d", &width, &height) == 2 || line[0] == '#' || line[0] == '\n') continue;
+            InputEvent e = {};
+            char type = 0;
+            ok = sscanf(line, "%lf %c", &e.time, &type) == 2;
+            e.type = type;
+            const char* args = ok ? strchr(line, type) + 1 : line;
+            switch (type) {
+                case INPUT_KEY: ok = ok && sscanf(args, "%d %d %d %d", &e.a, &e.b, &e.c, &e.d) == 4; break;
+                case INPUT_MOUSE_BUTTON: ok = ok && sscanf(args, "%d %d %d", &e.a, &e.b, &e.c) == 3; break;
+                case INPUT_CURSOR: ok = ok && sscanf(args, "%lf %lf", &e.x, &e.y) == 2; break;
+                case INPUT_RESIZE: ok = ok && sscanf(args, "%d %d", &e.a, &e.b) == 2; break;
+                case INPUT_END: ended = true; break;
+                default: ok = false; break;
+            }
+            if (ok) events.push_back(e);
+        }
+        fclose(file);
+        if (!ok || !ended) {
+            std::cerr << "Erro: gravação " << fileName << (ok ? " incompleta (sem fim)" : " com linha inválida") << std::endl;
+            return false;
+        }
+        std::stable_sort(events.begin(), events.end(),
+                         [](const InputEvent& a, const InputEvent& b) { return a.time < b.time; });
+        return true;
+    }
+
+    // Próxima entrada com tempo <= until (false quando não há mais até esse instante)
+    bool poll(double until, InputEvent& e) {
+        if (next >= events.size() || events[next].time > until || events[next].type == INPUT_END) return false;
+        e = events[next++];
+        return true;
+    }
+
+    bool finished(double now) const { return events.empty() || now >= events.back().time; }
+
+    int width = 0, height = 0; // tamanho da janela no início da gravação
+
+private:
+    std::vector<InputEvent> events;
+    size_t next = 0;
+};
+
+// Tempos por quadro: CPU (atualização + envio dos comandos), GPU (timer query,
+// chega alguns quadros depois) e o quadro inteiro. Grava CSV e imprime percentis.
+class FrameLog {
+public:
+    void add(int events, double cpuMs, double frameMs) { frames.push_back({ events, cpuMs, -1.0, frameMs }); }
+    void setGpu(size_t frame, double gpuMs) {
+        if (frame < frames.size()) frames[frame].gpuMs = gpuMs;
+    }
+    size_t size() const { return frames.size(); }
+
+    bool write(const std::string& fileName) const {
+        FILE* file = fopen(fileName.c_str(), "w");
+        if (!file) {
+            std::cerr << "Erro: não foi possível criar " << fileName << std::endl;
+            return false;
+        }
+        fprintf(file, "quadro,eventos,cpu_ms,gpu_ms,quadro_ms\n");
+        for (size_t f = 0; f < frames.size(); ++f)
+            fprintf(file, "%zu,%d,%.4f,%.4f,%.4f\n", f, frames[f].events, frames[f].cpuMs, frames[f].gpuMs,
+                    frames[f].frameMs);
+        fclose(file);
+        return true;
+    }
+
+    void printSummary() const {
+        if (frames.empty()) return;
+        auto column = [this](double Frame::*field) {
+            std::vector<double> values;
+            for (const Frame& f : frames)
+                if (f.*field >= 0) values.push_back(f.*field);
+            std::sort(values.begin(), values.end());
+            return values;
+        };
+        auto percentile = [](const std::vector<double>& v, double p) {
+            return v.empty() ? 0.0 : v[std::min(v.size() - 1, (size_t)(p * v.size()))];
+        };
+        printf("%zu quadros\n%-8s %9s %9s %9s %9s\n", frames.size(), "ms", "p50", "p95", "p99", "max");
+        const char* names[] = { "cpu", "gpu", "quadro" };
+        double Frame::*fields[] = { &Frame::cpuMs, &Frame::gpuMs, &Frame::frameMs };
+        for (int i = 0; i < 3; ++i) {
+            std::vector<double> v = column(fields[i]);
+            printf("%-8s %9.3f %9.3f %9.3f %9.3f\n", names[i], percentile(v, 0.50), percentile(v, 0.95),
+                   percentile(v, 0.99), v.empty() ? 0.0 : v.back());
+        }
+    }
+
+private:
+    struct Frame {
+        int events;
+        double cpuMs, gpuMs, frameMs;
+    };
+    std::vector<Frame> frames;
+};
+
+#endif
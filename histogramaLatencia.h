@@ -0,0 +1,88 @@
+#ifndef HISTOGRAMA_LATENCIA_H
+#define HISTOGRAMA_LATENCIA_H
+
+// Histograma de latências em escala log-linear: cada potência de 2 de nanossegundos
+// é dividida em SUB faixas iguais, então um percentil sai com erro relativo abaixo
+// de 1/SUB e o histograma tem tamanho fixo, sem guardar as amostras. Um escritor por
+// histograma (contadores atômicos relaxados); leitores podem somar vários com merge().
+// Os valores não precisam ser tempos: metricasConsultas.h usa o mesmo histograma
+// para vértices, arestas e bytes por consulta.
+
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+#include <algorithm>
+
+class LatencyHistogram {
+public:
+    static constexpr int SUB_BITS = 4;
+    static constexpr int SUB = 1 << SUB_BITS;
+    static constexpr int BUCKETS = (64 - SUB_BITS + 1) * SUB;
+
+    LatencyHistogram() { reset(); }
+    LatencyHistogram(const LatencyHistogram& other) {
+        reset();
+        merge(other);
+    }
+
+    void record(uint64_t ns) {
+        counts[bucketOf(ns)].fetch_add(1, std::memory_order_relaxed);
+        total.fetch_add(1, std::memory_order_relaxed);
+        sum.fetch_add(ns, std::memory_order_relaxed);
+        if (ns > maximum.load(std::memory_order_relaxed)) maximum.store(ns, std::memory_order_relaxed);
+    }
+
+    void merge(const LatencyHistogram& other) {
+        for (int b = 0; b < BUCKETS; ++b)
+            counts[b].fetch_add(other.counts[b].load(std::memory_order_relaxed), std::memory_order_relaxed);
+        total.fetch_add(other.count(), std::memory_order_relaxed);
+        sum.fetch_add(other.sum.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        if (other.max() > max()) maximum.store(other.max(), std::memory_order_relaxed);
+    }
+
+    void reset() {
+        for (auto& c : counts) c.store(0, std::memory_order_relaxed);
+        total.store(0, std::memory_order_relaxed);
+        sum.store(0, std::memory_order_relaxed);
+        maximum.store(0, std::memory_order_relaxed);
+    }
+
+    uint64_t count() const { return total.load(std::memory_order_relaxed); }
+    uint64_t max() const { return maximum.load(std::memory_order_relaxed); }
+    uint64_t valueSum() const { return sum.load(std::memory_order_relaxed); }
+    double mean() const { return count() ? (double)valueSum() / count() : 0.0; }
+
+    // Limite superior da faixa que contém o percentil p (0 a 1); 0 se vazio
+    uint64_t percentile(double p) const {
+        uint64_t n = count();
+        if (n == 0) return 0;
+        uint64_t rank = (uint64_t)(p * (n - 1)) + 1, seen = 0;
+        for (int b = 0; b < BUCKETS; ++b) {
+            seen += counts[b].load(std::memory_order_relaxed);
+            if (seen >= rank) return std::min(upperBound(b), max());
+        }
+        return max();
+    }
+
+    // Faixas para exportação: limite superior (ns) e contagem de cada uma
+    static uint64_t upperBound(int bucket) {
+        if (bucket < SUB) return (uint64_t)bucket;
+        int shift = bucket / SUB - 1;
+        uint64_t lower = (uint64_t)(SUB + bucket % SUB) << shift;
+        return lower + ((uint64_t)1 << shift) - 1;
+    }
+    uint64_t bucketCount(int bucket) const { return counts[bucket].load(std::memory_order_relaxed); }
+
+private:
+    static int bucketOf(uint64_t ns) {
+        if (ns < (uint64_t)SUB) return (int)ns;
+        int msb = 63 - __builtin_clzll(ns);
+        int shift = msb - SUB_BITS;
+        return (shift + 1) * SUB + (int)((ns >> shift) & (SUB - 1));
+    }
+
+    std::atomic<uint64_t> counts[BUCKETS];
+    std::atomic<uint64_t> total, sum, maximum;
+};
+
+#endif
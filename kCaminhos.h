@@ -0,0 +1,261 @@
+#ifndef K_CAMINHOS_H
+#define K_CAMINHOS_H
+
+// K caminhos mínimos sem ciclos (algoritmo de Yen).
+// Uma única busca reversa a partir do destino dá, para todo vértice, a distância
+// exata até o destino e o próximo vértice da árvore de caminhos mínimos. Com isso:
+//  - se o caminho da árvore a partir do nó de desvio não passa pelo que foi
+//    removido, ele já é o desvio ótimo e nenhuma busca é feita;
+//  - caso contrário o desvio é um A* guiado por essa distância, que continua
+//    sendo uma estimativa admissível e consistente após remover arestas/vértices.
+//    O A* termina no primeiro vértice retirado do heap cujo caminho na árvore
+//    está livre, pois dali em diante a árvore já dá o complemento ótimo.
+
+#include <vector>
+#include <set>
+#include <cstdint>
+#include <algorithm>
+#include "caminhoMinimo.h"
+
+template <typename W, typename Index = uint32_t>
+struct RankedPath {
+    DistanceOf<W> cost;
+    std::vector<Index> vertices;
+    std::vector<DistanceOf<W>> prefixCost; // custo da origem até vertices[i]
+};
+
+template <typename W, typename Index = uint32_t>
+class YenKShortest {
+public:
+    typedef DistanceOf<W> Distance; // custos somados, como no DijkstraEngine
+    typedef WeightTraits<Distance> Traits;
+
+    explicit YenKShortest(const Graph<W, Index>& graph)
+        : graph(&graph), reverse(reverseOf(graph)), reverseEngine(reverse) {}
+
+    // reverseEngine aponta para o próprio membro reverse
+    YenKShortest(const YenKShortest&) = delete;
+    YenKShortest& operator=(const YenKShortest&) = delete;
+
+    // Até k caminhos source -> target em ordem de custo; devolve false se stop() cancelar
+    template <typename Stop>
+    bool run(Index source, Index target, size_t k, std::vector<RankedPath<W, Index>>& out, Stop stop) {
+        out.clear();
+        if (k == 0) return true;
+
+        // Árvore reversa: distância até target e próximo vértice rumo a ele
+        if (!reverseEngine.run(target, noVertex<Index>(), stop)) return false;
+        if (!reverseEngine.reached(source)) return true;
+
+        // Carimbos sobrevivem entre chamadas; só são refeitos se o grafo mudou de tamanho
+        size_t n = graph->numVertices();
+        if (blockedStamp.size() != n) {
+            blockedStamp.assign(n, 0);
+            cleanStamp.assign(n, 0);
+            cleanValue.assign(n, 0);
+            blockEpoch = 0;
+        }
+
+        RankedPath<W, Index> first;
+        first.vertices.push_back(source);
+        first.prefixCost.push_back(0);
+        appendTreePath(source, first);
+        first.cost = first.prefixCost.back();
+        out.push_back(first);
+
+        std::set<std::vector<Index>> seen;
+        seen.insert(first.vertices);
+        std::vector<RankedPath<W, Index>> candidates;
+        std::vector<Index> removedNext;
+        std::vector<Index> spurPath;
+        std::vector<Distance> spurCost;
+
+        while (out.size() < k) {
+            if (stop()) return false;
+            const RankedPath<W, Index>& previous = out.back();
+
+            for (size_t i = 0; i + 1 < previous.vertices.size(); ++i) {
+                Index spur = previous.vertices[i];
+
+                // Arestas que saem do nó de desvio e já foram usadas com a mesma raiz
+                removedNext.clear();
+                for (const auto& p : out)
+                    if (p.vertices.size() > i + 1 &&
+                        std::equal(p.vertices.begin(), p.vertices.begin() + i + 1, previous.vertices.begin()))
+                        removedNext.push_back(p.vertices[i + 1]);
+
+                // Vértices da raiz ficam bloqueados (o nó de desvio só pode ser o início)
+                if (++blockEpoch == 0) {
+                    std::fill(blockedStamp.begin(), blockedStamp.end(), 0);
+                    std::fill(cleanStamp.begin(), cleanStamp.end(), 0);
+                    blockEpoch = 1;
+                }
+                for (size_t j = 0; j <= i; ++j) blockedStamp[previous.vertices[j]] = blockEpoch;
+
+                RankedPath<W, Index> candidate;
+                candidate.vertices.assign(previous.vertices.begin(), previous.vertices.begin() + i + 1);
+                candidate.prefixCost.assign(previous.prefixCost.begin(), previous.prefixCost.begin() + i + 1);
+
+                if (treePathUsable(spur, removedNext)) {
+                    appendTreePath(spur, candidate);
+                } else {
+                    if (!spurSearch(spur, removedNext, spurPath, spurCost)) continue;
+                    Distance base = candidate.prefixCost.back();
+                    for (size_t j = 1; j < spurPath.size(); ++j) {
+                        candidate.vertices.push_back(spurPath[j]);
+                        candidate.prefixCost.push_back(Traits::add(base, spurCost[j]));
+                    }
+                    appendTreePath(candidate.vertices.back(), candidate);
+                }
+                candidate.cost = candidate.prefixCost.back();
+                if (seen.insert(candidate.vertices).second) candidates.push_back(std::move(candidate));
+            }
+
+            if (candidates.empty()) break;
+            auto best = std::min_element(candidates.begin(), candidates.end(),
+                [](const RankedPath<W, Index>& a, const RankedPath<W, Index>& b) { return a.cost < b.cost; });
+            out.push_back(std::move(*best));
+            *best = std::move(candidates.back());
+            candidates.pop_back();
+        }
+        return true;
+    }
+
+    bool run(Index source, Index target, size_t k, std::vector<RankedPath<W, Index>>& out) {
+        return run(source, target, k, out, [] { return false; });
+    }
+
+private:
+    static Graph<W, Index> reverseOf(const Graph<W, Index>& g) {
+        std::vector<Edge<W, Index>> edges;
+        edges.reserve(g.numEdges());
+        for (Index v = 0; v < g.numVertices(); ++v)
+            for (size_t e = g.offsets[v]; e < g.offsets[(size_t)v + 1]; ++e)
+                edges.push_back({ g.targets[e], v, g.weights[e] });
+        return Graph<W, Index>::fromEdges(g.numVertices(), edges);
+    }
+
+    Index treeNext(Index v) const { return reverseEngine.predecessor(v); }
+    Distance toTarget(Index v) const { return reverseEngine.distance(v); }
+
+    // O caminho da árvore a partir de spur evita a raiz e as arestas removidas?
+    bool treePathUsable(Index spur, const std::vector<Index>& removedNext) {
+        if (!reverseEngine.reached(spur)) return false;
+        Index next = treeNext(spur);
+        if (next == noVertex<Index>()) return true; // spur é o próprio destino
+        if (std::find(removedNext.begin(), removedNext.end(), next) != removedNext.end()) return false;
+        return treeClean(next);
+    }
+
+    // O caminho da árvore de v até o destino não toca vértices bloqueados?
+    // Memorizado por blockEpoch, então cada vértice é avaliado uma vez por desvio.
+    bool treeClean(Index v) {
+        walk.clear();
+        bool clean = true;
+        for (Index u = v; u != noVertex<Index>(); u = treeNext(u)) {
+            if (cleanStamp[u] == blockEpoch) {
+                clean = cleanValue[u];
+                break;
+            }
+            if (blockedStamp[u] == blockEpoch) {
+                clean = false;
+                walk.push_back(u);
+                break;
+            }
+            walk.push_back(u);
+        }
+        for (Index u : walk) {
+            cleanStamp[u] = blockEpoch;
+            cleanValue[u] = clean;
+        }
+        return clean;
+    }
+
+    // Acrescenta o caminho da árvore de v até o destino (v já está no caminho)
+    void appendTreePath(Index v, RankedPath<W, Index>& path) const {
+        Distance base = path.prefixCost.back();
+        Distance remaining = toTarget(v);
+        for (Index u = treeNext(v); u != noVertex<Index>(); u = treeNext(u)) {
+            path.vertices.push_back(u);
+            path.prefixCost.push_back(Traits::add(base, remaining - toTarget(u)));
+        }
+    }
+
+    // A* a partir de spur sem passar por vértices bloqueados nem pelas arestas removidas.
+    // Devolve o trecho spur -> u, onde u é o primeiro vértice com caminho livre na árvore.
+    bool spurSearch(Index spur, const std::vector<Index>& removedNext,
+                    std::vector<Index>& outPath, std::vector<Distance>& outCost) {
+        spurSpace.begin(graph->numVertices());
+        heap.clear();
+        spurSpace.touch(spur);
+        spurSpace.dist[spur] = 0;
+        pushHeap({ toTarget(spur), spur });
+
+        Index meet = noVertex<Index>();
+        while (!heap.empty()) {
+            HeapEntry top = popHeap();
+            Index v = top.vertex;
+            if (Traits::add(spurSpace.dist[v], toTarget(v)) != top.priority) continue; // entrada obsoleta
+            if (v != spur && treeClean(v)) {
+                meet = v;
+                break;
+            }
+
+            for (size_t e = graph->offsets[v]; e < graph->offsets[(size_t)v + 1]; ++e) {
+                Index w = graph->targets[e];
+                if (blockedStamp[w] == blockEpoch) continue;
+                if (v == spur && std::find(removedNext.begin(), removedNext.end(), w) != removedNext.end())
+                    continue;
+                if (!reverseEngine.reached(w)) continue; // não chega ao destino
+                spurSpace.touch(w);
+                Distance candidate = Traits::add(spurSpace.dist[v], (Distance)graph->weights[e]);
+                if (candidate < spurSpace.dist[w]) {
+                    spurSpace.dist[w] = candidate;
+                    spurSpace.path[w] = v;
+                    pushHeap({ Traits::add(candidate, toTarget(w)), w });
+                }
+            }
+        }
+
+        if (meet == noVertex<Index>()) return false;
+        outPath.clear();
+        outCost.clear();
+        for (Index v = meet; v != noVertex<Index>(); v = spurSpace.path[v]) {
+            outPath.push_back(v);
+            outCost.push_back(spurSpace.dist[v]);
+        }
+        std::reverse(outPath.begin(), outPath.end());
+        std::reverse(outCost.begin(), outCost.end());
+        return true;
+    }
+
+    struct HeapEntry {
+        Distance priority;
+        Index vertex;
+        bool operator>(const HeapEntry& other) const { return priority > other.priority; }
+    };
+
+    void pushHeap(const HeapEntry& entry) {
+        heap.push_back(entry);
+        std::push_heap(heap.begin(), heap.end(), std::greater<HeapEntry>());
+    }
+
+    HeapEntry popHeap() {
+        std::pop_heap(heap.begin(), heap.end(), std::greater<HeapEntry>());
+        HeapEntry top = heap.back();
+        heap.pop_back();
+        return top;
+    }
+
+    const Graph<W, Index>* graph;
+    Graph<W, Index> reverse;
+    DijkstraEngine<W, Index> reverseEngine;
+    std::vector<uint32_t> blockedStamp, cleanStamp;
+    std::vector<char> cleanValue;
+    std::vector<Index> walk;
+    uint32_t blockEpoch = 0;
+    QueryWorkspace<Distance, Index> spurSpace; // estado do A* de desvio
+    std::vector<HeapEntry> heap;
+};
+
+#endif
@@ -0,0 +1,88 @@
+#ifndef METRICAS_CONSULTAS_H
+#define METRICAS_CONSULTAS_H
+
+// Estatísticas por consulta (SearchStats, caminhoMinimo.h) agregadas em histogramas
+// e exportadas no formato de texto do Prometheus. Como no LatencyHistogram, cada
+// QueryMetrics tem um escritor (uma por thread) e os leitores somam com merge().
+// O texto pode ir para um arquivo (coletor textfile do node_exporter) ou ser
+// servido por HTTP (servidor.cpp, --metricas-porta).
+
+#include <string>
+#include <cstdio>
+#include <cstdint>
+#include "caminhoMinimo.h"
+#include "histogramaLatencia.h"
+
+class QueryMetrics {
+public:
+    void record(const SearchStats& s) {
+        settled.record(s.settled);
+        relaxed.record(s.relaxed);
+        decreaseKeys.record(s.decreaseKeys);
+        heapPeak.record(s.heapPeak);
+        bytesAllocated.record(s.bytesAllocated);
+        duration.record(s.nanoseconds);
+    }
+
+    void merge(const QueryMetrics& other) {
+        settled.merge(other.settled);
+        relaxed.merge(other.relaxed);
+        decreaseKeys.merge(other.decreaseKeys);
+        heapPeak.merge(other.heapPeak);
+        bytesAllocated.merge(other.bytesAllocated);
+        duration.merge(other.duration);
+    }
+
+    uint64_t count() const { return duration.count(); }
+
+    LatencyHistogram settled, relaxed, decreaseKeys, heapPeak, bytesAllocated;
+    LatencyHistogram duration; // ns
+};
+
+// Um histograma do Prometheus: faixas cumulativas no fim de cada potência de 2 (até
+// a que contém o máximo), +Inf, _sum e _count. scale converte a unidade guardada na
+// exportada (ns -> s).
+inline void appendPrometheusHistogram(std::string& out, const std::string& name, const char* help,
+                                      const LatencyHistogram& h, double scale = 1.0) {
+    char line[256];
+    out += "# HELP " + name + " " + help + "\n# TYPE " + name + " histogram\n";
+    // O total sai das faixas, não de count(): com escritores ativos os dois podem
+    // divergir por algumas amostras, e o formato exige +Inf igual a _count
+    uint64_t total = 0, cumulative = 0;
+    for (int b = 0; b < LatencyHistogram::BUCKETS; ++b) total += h.bucketCount(b);
+    for (int b = 0; b < LatencyHistogram::BUCKETS; ++b) {
+        cumulative += h.bucketCount(b);
+        if (b % LatencyHistogram::SUB != LatencyHistogram::SUB - 1) continue;
+        snprintf(line, sizeof(line), "%s_bucket{le=\"%.9g\"} %llu\n", name.c_str(),
+                 LatencyHistogram::upperBound(b) * scale, (unsigned long long)cumulative);
+        out += line;
+        if (cumulative == total) break;
+    }
+    snprintf(line, sizeof(line), "%s_bucket{le=\"+Inf\"} %llu\n%s_sum %.9g\n%s_count %llu\n", name.c_str(),
+             (unsigned long long)total, name.c_str(), h.valueSum() * scale, name.c_str(), (unsigned long long)total);
+    out += line;
+}
+
+// Todas as métricas de consulta, com nomes prefix_<métrica>
+inline void appendPrometheusMetrics(std::string& out, const std::string& prefix, const QueryMetrics& m) {
+    appendPrometheusHistogram(out, prefix + "_settled_vertices", "Vértices fixados por consulta.", m.settled);
+    appendPrometheusHistogram(out, prefix + "_relaxed_edges", "Arestas examinadas por consulta.", m.relaxed);
+    appendPrometheusHistogram(out, prefix + "_decrease_keys", "Distâncias finitas reduzidas por consulta.",
+                              m.decreaseKeys);
+    appendPrometheusHistogram(out, prefix + "_heap_peak", "Maior tamanho do heap por consulta.", m.heapPeak);
+    appendPrometheusHistogram(out, prefix + "_allocated_bytes", "Bytes reservados pelo motor por consulta.",
+                              m.bytesAllocated);
+    appendPrometheusHistogram(out, prefix + "_duration_seconds", "Tempo de busca por consulta.", m.duration, 1e-9);
+}
+
+// Grava de forma atômica (temporário + rename): quem lê nunca vê um arquivo pela metade
+inline bool writeMetricsFile(const std::string& path, const std::string& text) {
+    std::string temporary = path + ".tmp";
+    FILE* file = fopen(temporary.c_str(), "w");
+    if (!file) return false;
+    bool ok = fwrite(text.data(), 1, text.size(), file) == text.size();
+    ok = fclose(file) == 0 && ok;
+    return ok && rename(temporary.c_str(), path.c_str()) == 0;
+}
+
+#endif
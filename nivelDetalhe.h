@@ -0,0 +1,215 @@
+#ifndef NIVEL_DETALHE_H
+#define NIVEL_DETALHE_H
+
+// Níveis de detalhe para grafos vistos de longe. Os vértices são agrupados numa
+// quadtree sobre as posições: o nível 0 é uma grade de 2^D x 2^D células (só as
+// não vazias viram clusters) e cada nível acima junta 2 x 2 células do anterior.
+// Cada cluster guarda o centróide e o número de vértices; as arestas entre clusters
+// diferentes são agrupadas em feixes (um por par de clusters, sem direção) com a
+// contagem de arestas. Na tela, o nível é escolhido pelo tamanho das células em
+// pixels, e as posições de um nível são interpoladas com as do nível acima
+// (geomorphing), para o refinamento ser contínuo durante o zoom.
+
+#include <cmath>
+#include <vector>
+#include <cstdint>
+#include <algorithm>
+#include "caminhoMinimo.h"
+#include "arquivoGrafo.h"
+
+template <typename Index = uint32_t>
+class ClusterHierarchy {
+public:
+    struct Level {
+        uint32_t resolution;               // células por lado
+        std::vector<Coordinate> centers;   // centróide de cada cluster
+        std::vector<Index> counts;         // vértices em cada cluster
+        std::vector<Index> parents;        // cluster no nível seguinte (mais grosso)
+        std::vector<uint64_t> bundles;     // feixes: (a << 32) | b, a < b, ordenados
+        std::vector<uint32_t> bundleEdges; // arestas em cada feixe
+
+        static Index bundleFrom(uint64_t bundle) { return (Index)(bundle >> 32); }
+        static Index bundleTo(uint64_t bundle) { return (Index)(bundle & 0xffffffffu); }
+    };
+
+    // Monta a hierarquia; positions tem uma entrada por vértice do grafo
+    template <typename W>
+    void build(const Graph<W, Index>& graph, const Coordinate* positions) {
+        levels.clear();
+        vertexCluster.clear();
+        Index n = graph.numVertices();
+        if (n == 0) return;
+
+        float minX = positions[0].x, maxX = minX, minY = positions[0].y, maxY = minY;
+        for (Index v = 1; v < n; ++v) {
+            minX = std::min(minX, positions[v].x);
+            maxX = std::max(maxX, positions[v].x);
+            minY = std::min(minY, positions[v].y);
+            maxY = std::max(maxY, positions[v].y);
+        }
+        side = std::max(std::max(maxX - minX, maxY - minY), 1e-6f);
+
+        // Nível mais fino com, em média, pelo menos 2 vértices por célula ocupada
+        int depth = 1;
+        while (depth < 16 && (uint64_t)1 << (2 * (depth + 1)) <= (uint64_t)n / 2) ++depth;
+        uint32_t resolution = 1u << depth;
+
+        // Vértices ordenados pelo código de Morton da célula: cada cluster (em qualquer
+        // nível) é um intervalo contíguo dessa ordem
+        std::vector<uint64_t> keyed(n);
+        for (Index v = 0; v < n; ++v) {
+            uint32_t x = std::min(resolution - 1, (uint32_t)((positions[v].x - minX) / side * resolution));
+            uint32_t y = std::min(resolution - 1, (uint32_t)((positions[v].y - minY) / side * resolution));
+            keyed[v] = (uint64_t)morton(x, y) << 32 | v;
+        }
+        std::sort(keyed.begin(), keyed.end());
+
+        levels.emplace_back();
+        Level& finest = levels.back();
+        finest.resolution = resolution;
+        std::vector<uint32_t> keys; // célula de cada cluster do nível atual
+        vertexCluster.resize(n);
+        for (size_t i = 0; i < keyed.size(); ++i) {
+            uint32_t key = (uint32_t)(keyed[i] >> 32);
+            Index v = (Index)(keyed[i] & 0xffffffffu);
+            if (keys.empty() || keys.back() != key) {
+                keys.push_back(key);
+                finest.centers.push_back({ 0.0f, 0.0f });
+                finest.counts.push_back(0);
+            }
+            Index c = (Index)(keys.size() - 1);
+            vertexCluster[v] = c;
+            finest.centers[c].x += positions[v].x;
+            finest.centers[c].y += positions[v].y;
+            ++finest.counts[c];
+        }
+        for (size_t c = 0; c < finest.centers.size(); ++c) {
+            finest.centers[c].x /= finest.counts[c];
+            finest.centers[c].y /= finest.counts[c];
+        }
+
+        std::vector<uint64_t> pairs;
+        pairs.reserve(graph.numEdges());
+        for (Index v = 0; v < n; ++v)
+            for (size_t e = graph.offsets[v]; e < graph.offsets[(size_t)v + 1]; ++e) {
+                Index a = vertexCluster[v], b = vertexCluster[graph.targets[e]];
+                if (a != b) pairs.push_back((uint64_t)std::min(a, b) << 32 | std::max(a, b));
+            }
+        std::sort(pairs.begin(), pairs.end());
+        for (uint64_t pair : pairs) {
+            if (!finest.bundles.empty() && finest.bundles.back() == pair) {
+                ++finest.bundleEdges.back();
+            } else {
+                finest.bundles.push_back(pair);
+                finest.bundleEdges.push_back(1);
+            }
+        }
+        std::vector<uint64_t>().swap(pairs);
+
+        // Níveis mais grossos: cada célula junta 2 x 2 células do nível anterior
+        while (levels.back().resolution > 2) {
+            levels.emplace_back();
+            Level& fine = levels[levels.size() - 2];
+            Level& coarse = levels.back();
+            coarse.resolution = fine.resolution / 2;
+            std::vector<uint32_t> coarseKeys;
+            fine.parents.resize(fine.centers.size());
+            for (size_t c = 0; c < fine.centers.size(); ++c) {
+                uint32_t key = keys[c] >> 2;
+                if (coarseKeys.empty() || coarseKeys.back() != key) {
+                    coarseKeys.push_back(key);
+                    coarse.centers.push_back({ 0.0f, 0.0f });
+                    coarse.counts.push_back(0);
+                }
+                Index p = (Index)(coarseKeys.size() - 1);
+                fine.parents[c] = p;
+                coarse.centers[p].x += fine.centers[c].x * fine.counts[c];
+                coarse.centers[p].y += fine.centers[c].y * fine.counts[c];
+                coarse.counts[p] += fine.counts[c];
+            }
+            for (size_t c = 0; c < coarse.centers.size(); ++c) {
+                coarse.centers[c].x /= coarse.counts[c];
+                coarse.centers[c].y /= coarse.counts[c];
+            }
+
+            std::vector<std::pair<uint64_t, uint32_t>> merged;
+            for (size_t i = 0; i < fine.bundles.size(); ++i) {
+                Index a = fine.parents[Level::bundleFrom(fine.bundles[i])];
+                Index b = fine.parents[Level::bundleTo(fine.bundles[i])];
+                if (a != b) merged.push_back({ (uint64_t)std::min(a, b) << 32 | std::max(a, b), fine.bundleEdges[i] });
+            }
+            std::sort(merged.begin(), merged.end());
+            for (const auto& m : merged) {
+                if (!coarse.bundles.empty() && coarse.bundles.back() == m.first) {
+                    coarse.bundleEdges.back() += m.second;
+                } else {
+                    coarse.bundles.push_back(m.first);
+                    coarse.bundleEdges.push_back(m.second);
+                }
+            }
+            keys.swap(coarseKeys);
+        }
+    }
+
+    size_t numLevels() const { return levels.size(); }
+    const Level& level(size_t i) const { return levels[i]; }
+    float extent() const { return side; }
+
+    Index clusterOf(Index v, size_t level) const {
+        Index c = vertexCluster[v];
+        for (size_t l = 0; l < level; ++l) c = levels[l].parents[c];
+        return c;
+    }
+
+    // Índice do feixe entre os clusters a e b do nível, ou -1
+    long findBundle(size_t level, Index a, Index b) const {
+        const std::vector<uint64_t>& bundles = levels[level].bundles;
+        uint64_t key = (uint64_t)std::min(a, b) << 32 | std::max(a, b);
+        auto it = std::lower_bound(bundles.begin(), bundles.end(), key);
+        return it != bundles.end() && *it == key ? (long)(it - bundles.begin()) : -1;
+    }
+
+    // Nível para células de cerca de cellPixels quando a hierarquia inteira ocupa
+    // extentPixels na tela. Devolve false quando o grafo completo deve ser desenhado;
+    // t em (0, 1] vai do nível acima (perto de 0) ao escolhido (1).
+    bool chooseLevel(float extentPixels, float cellPixels, size_t& level, float& t) const {
+        if (levels.empty()) return false;
+        float wanted = std::log2(std::max(extentPixels / cellPixels, 1.0f)); // log2 da resolução desejada
+        float finest = std::log2((float)levels[0].resolution);
+        if (wanted > finest + 1.0f) return false;
+        float coarsest = std::log2((float)levels.back().resolution);
+        wanted = std::max(std::min(wanted, finest), coarsest);
+        int chosen = (int)std::ceil(wanted);
+        level = (size_t)(finest - chosen);
+        t = level + 1 < levels.size() ? 1.0f - (chosen - wanted) : 1.0f;
+        return true;
+    }
+
+    // Centróides do nível interpolados com os do nível acima
+    void morphedCenters(size_t level, float t, std::vector<Coordinate>& out) const {
+        const Level& l = levels[level];
+        out.resize(l.centers.size());
+        for (size_t c = 0; c < l.centers.size(); ++c) {
+            Coordinate own = l.centers[c];
+            Coordinate parent = level + 1 < levels.size() ? levels[level + 1].centers[l.parents[c]] : own;
+            out[c] = { parent.x + (own.x - parent.x) * t, parent.y + (own.y - parent.y) * t };
+        }
+    }
+
+private:
+    static uint32_t spread(uint32_t x) {
+        x &= 0xffff;
+        x = (x | (x << 8)) & 0x00ff00ff;
+        x = (x | (x << 4)) & 0x0f0f0f0f;
+        x = (x | (x << 2)) & 0x33333333;
+        x = (x | (x << 1)) & 0x55555555;
+        return x;
+    }
+    static uint32_t morton(uint32_t x, uint32_t y) { return spread(x) | spread(y) << 1; }
+
+    std::vector<Level> levels;
+    std::vector<Index> vertexCluster; // cluster de cada vértice no nível 0
+    float side = 0.0f;
+};
+
+#endif
@@ -0,0 +1,71 @@
+#ifndef PROTOCOLO_CONSULTAS_H
+#define PROTOCOLO_CONSULTAS_H
+
+// Protocolo binário do servidor de consultas (servidor.cpp) sobre um socket Unix.
+// Tudo em uint32 na ordem de bytes da máquina (cliente e servidor são locais).
+//   pedido:   id, tipo, origem, destino                          (16 bytes)
+//   resposta: id, status, distância, palavras                    (16 bytes)
+//             seguida de `palavras` uint32: o caminho (QUERY_PATH) ou ServerStats
+// O cliente pode enviar vários pedidos sem esperar (pipelining); as respostas de
+// uma conexão chegam na ordem em que terminam, e o id diz a que pedido pertencem.
+
+#include <cstdint>
+#include <cerrno>
+#include <unistd.h>
+
+enum QueryType : uint32_t {
+    QUERY_DISTANCE = 0, // só a distância
+    QUERY_PATH = 1,     // distância e caminho (vértices da origem ao destino)
+    QUERY_STATS = 2,    // ServerStats; origem e destino são ignorados
+};
+
+enum QueryStatus : uint32_t {
+    STATUS_OK = 0,
+    STATUS_UNREACHABLE = 1,   // destino inalcançável (distância = UINT32_MAX)
+    STATUS_BAD_VERTEX = 2,    // origem ou destino fora do grafo
+    STATUS_BAD_REQUEST = 3,   // tipo desconhecido
+};
+
+struct QueryRequest {
+    uint32_t id, type, source, target;
+};
+
+struct QueryReply {
+    uint32_t id, status, distance, words;
+};
+
+// Latências medidas no servidor, do pedido lido ao envio da resposta (ns)
+struct ServerStats {
+    uint64_t vertices, edges, workers;
+    uint64_t queries, p50, p90, p99, max;
+};
+
+static_assert(sizeof(QueryRequest) == 16 && sizeof(QueryReply) == 16, "protocolo com tamanho fixo");
+static_assert(sizeof(ServerStats) % 4 == 0, "ServerStats é enviado em palavras de 32 bits");
+
+// Lê ou escreve exatamente size bytes num descritor bloqueante; false em erro ou fim
+inline bool readFully(int fd, void* data, size_t size) {
+    char* p = (char*)data;
+    while (size > 0) {
+        ssize_t n = read(fd, p, size);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) return false;
+        p += n;
+        size -= (size_t)n;
+    }
+    return true;
+}
+
+inline bool writeFully(int fd, const void* data, size_t size) {
+    const char* p = (const char*)data;
+    while (size > 0) {
+        ssize_t n = write(fd, p, size);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) return false;
+        p += n;
+        size -= (size_t)n;
+    }
+    return true;
+}
+
+#endif
@@ -0,0 +1,268 @@
+#ifndef REORDENACAO_H
+#define REORDENACAO_H
+
+// Renumeração de vértices para localidade de cache.
+// Vértices vizinhos no grafo (BFS, Cuthill–McKee reverso) ou no plano (curva de
+// Hilbert) recebem ids próximos, então dist/path, o CSR e as posições usados juntos
+// ficam nas mesmas linhas de cache. Os motores trabalham só com ids novos; quem
+// chama converte na entrada (toNew) e na saída (toOld).
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <algorithm>
+#include "caminhoMinimo.h"
+
+enum VertexOrderKind { ORDER_IDENTITY, ORDER_BFS, ORDER_RCM, ORDER_HILBERT };
+
+// Permutação de vértices: toNew[id original] = id novo, toOld[id novo] = id original
+template <typename Index = uint32_t>
+struct VertexOrder {
+    std::vector<Index> toNew;
+    std::vector<Index> toOld;
+
+    static VertexOrder identity(Index n) {
+        VertexOrder order;
+        order.toOld.resize(n);
+        for (Index v = 0; v < n; ++v) order.toOld[v] = v;
+        order.toNew = order.toOld;
+        return order;
+    }
+
+    // Monta a partir da sequência de ids originais na nova ordem
+    static VertexOrder fromSequence(std::vector<Index> sequence) {
+        VertexOrder order;
+        order.toOld = std::move(sequence);
+        order.toNew.resize(order.toOld.size());
+        for (size_t v = 0; v < order.toOld.size(); ++v) order.toNew[order.toOld[v]] = (Index)v;
+        return order;
+    }
+
+    Index size() const { return (Index)toOld.size(); }
+
+    // Reordena um vetor por vértice (indexado pelo id original) para os ids novos
+    template <typename T>
+    std::vector<T> permute(const std::vector<T>& byOld) const {
+        std::vector<T> byNew(byOld.size());
+        for (size_t v = 0; v < toOld.size(); ++v) byNew[v] = byOld[toOld[v]];
+        return byNew;
+    }
+
+    // Converte uma sequência de ids novos (ex.: um caminho) de volta para os originais
+    template <typename T>
+    void mapToOld(std::vector<T>& ids) const {
+        for (T& v : ids) v = (T)toOld[v];
+    }
+};
+
+// Vizinhança sem direção (saída + entrada) em CSR, usada para as ordens por busca
+template <typename W, typename Index>
+void undirectedAdjacency(const Graph<W, Index>& graph, std::vector<size_t>& offsets, std::vector<Index>& neighbors) {
+    size_t n = graph.numVertices();
+    offsets.assign(n + 1, 0);
+    for (size_t v = 0; v < n; ++v) {
+        offsets[v + 1] += graph.offsets[v + 1] - graph.offsets[v];
+        for (size_t e = graph.offsets[v]; e < graph.offsets[v + 1]; ++e) offsets[(size_t)graph.targets[e] + 1]++;
+    }
+    for (size_t v = 0; v < n; ++v) offsets[v + 1] += offsets[v];
+
+    neighbors.resize(offsets[n]);
+    std::vector<size_t> fill(offsets.begin(), offsets.end() - 1);
+    for (size_t v = 0; v < n; ++v)
+        for (size_t e = graph.offsets[v]; e < graph.offsets[v + 1]; ++e) {
+            Index w = graph.targets[e];
+            neighbors[fill[v]++] = w;
+            neighbors[fill[w]++] = (Index)v;
+        }
+}
+
+// Ordem de visita de uma busca em largura, componente por componente
+template <typename W, typename Index>
+VertexOrder<Index> bfsOrder(const Graph<W, Index>& graph) {
+    std::vector<size_t> offsets;
+    std::vector<Index> neighbors;
+    undirectedAdjacency(graph, offsets, neighbors);
+
+    Index n = graph.numVertices();
+    std::vector<char> seen(n, 0);
+    std::vector<Index> sequence;
+    sequence.reserve(n);
+    for (Index root = 0; root < n; ++root) {
+        if (seen[root]) continue;
+        size_t head = sequence.size();
+        seen[root] = 1;
+        sequence.push_back(root);
+        for (; head < sequence.size(); ++head) {
+            Index v = sequence[head];
+            for (size_t e = offsets[v]; e < offsets[(size_t)v + 1]; ++e) {
+                Index w = neighbors[e];
+                if (!seen[w]) {
+                    seen[w] = 1;
+                    sequence.push_back(w);
+                }
+            }
+        }
+    }
+    return VertexOrder<Index>::fromSequence(std::move(sequence));
+}
+
+// Cuthill–McKee reverso: em cada componente parte de um vértice pseudo-periférico
+// (George–Liu), visita os vizinhos em ordem crescente de grau e inverte tudo no fim.
+// Reduz a banda da matriz de adjacência, ou seja, vizinhos ficam com ids próximos.
+template <typename W, typename Index>
+VertexOrder<Index> rcmOrder(const Graph<W, Index>& graph) {
+    std::vector<size_t> offsets;
+    std::vector<Index> neighbors;
+    undirectedAdjacency(graph, offsets, neighbors);
+
+    Index n = graph.numVertices();
+    auto degree = [&](Index v) { return offsets[(size_t)v + 1] - offsets[v]; };
+
+    // Raízes candidatas em ordem crescente de grau
+    std::vector<Index> byDegree(n);
+    for (Index v = 0; v < n; ++v) byDegree[v] = v;
+    std::stable_sort(byDegree.begin(), byDegree.end(), [&](Index a, Index b) { return degree(a) < degree(b); });
+
+    std::vector<char> seen(n, 0);
+    std::vector<uint32_t> level(n, 0), levelStamp(n, 0);
+    uint32_t stamp = 0;
+    std::vector<Index> sequence, queue;
+    sequence.reserve(n);
+
+    // BFS por níveis a partir de root; devolve a excentricidade e deixa os visitados em queue
+    auto levelBfs = [&](Index root) {
+        ++stamp;
+        queue.clear();
+        queue.push_back(root);
+        levelStamp[root] = stamp;
+        level[root] = 0;
+        uint32_t depth = 0;
+        for (size_t head = 0; head < queue.size(); ++head) {
+            Index v = queue[head];
+            depth = level[v];
+            for (size_t e = offsets[v]; e < offsets[(size_t)v + 1]; ++e) {
+                Index w = neighbors[e];
+                if (seen[w] || levelStamp[w] == stamp) continue;
+                levelStamp[w] = stamp;
+                level[w] = level[v] + 1;
+                queue.push_back(w);
+            }
+        }
+        return depth;
+    };
+
+    for (Index candidate : byDegree) {
+        if (seen[candidate]) continue;
+
+        // Pseudo-periférico: troca a raiz pelo vértice de menor grau do último nível
+        // enquanto a excentricidade crescer (poucas iterações na prática)
+        Index root = candidate;
+        uint32_t eccentricity = levelBfs(root);
+        for (int iteration = 0; iteration < 8; ++iteration) {
+            Index best = root;
+            for (size_t i = queue.size(); i-- > 0 && level[queue[i]] == eccentricity;)
+                if (best == root || degree(queue[i]) < degree(best)) best = queue[i];
+            if (best == root) break;
+            uint32_t next = levelBfs(best);
+            if (next <= eccentricity) break;
+            root = best;
+            eccentricity = next;
+        }
+
+        size_t head = sequence.size();
+        seen[root] = 1;
+        sequence.push_back(root);
+        for (; head < sequence.size(); ++head) {
+            Index v = sequence[head];
+            size_t first = sequence.size();
+            for (size_t e = offsets[v]; e < offsets[(size_t)v + 1]; ++e) {
+                Index w = neighbors[e];
+                if (!seen[w]) {
+                    seen[w] = 1;
+                    sequence.push_back(w);
+                }
+            }
+            std::stable_sort(sequence.begin() + first, sequence.end(),
+                             [&](Index a, Index b) { return degree(a) < degree(b); });
+        }
+    }
+    std::reverse(sequence.begin(), sequence.end());
+    return VertexOrder<Index>::fromSequence(std::move(sequence));
+}
+
+// Posição do ponto (x, y) na curva de Hilbert de um grid 2^16 x 2^16
+inline uint64_t hilbertIndex(uint32_t x, uint32_t y) {
+    const uint32_t side = 1u << 16;
+    uint64_t d = 0;
+    for (uint32_t s = side / 2; s > 0; s /= 2) {
+        uint32_t rx = (x & s) ? 1 : 0;
+        uint32_t ry = (y & s) ? 1 : 0;
+        d += (uint64_t)s * s * ((3 * rx) ^ ry);
+        if (ry == 0) {
+            if (rx == 1) {
+                x = side - 1 - x;
+                y = side - 1 - y;
+            }
+            std::swap(x, y);
+        }
+    }
+    return d;
+}
+
+// Ordena os vértices pela curva de Hilbert das posições (qualquer tipo com .x e .y)
+template <typename Index = uint32_t, typename Point>
+VertexOrder<Index> hilbertOrder(const Point* positions, Index n) {
+    if (n == 0) return VertexOrder<Index>();
+    float minX = positions[0].x, maxX = minX, minY = positions[0].y, maxY = minY;
+    for (Index v = 1; v < n; ++v) {
+        minX = std::min(minX, (float)positions[v].x);
+        maxX = std::max(maxX, (float)positions[v].x);
+        minY = std::min(minY, (float)positions[v].y);
+        maxY = std::max(maxY, (float)positions[v].y);
+    }
+    float extent = std::max(std::max(maxX - minX, maxY - minY), 1e-6f);
+    float cell = 65535.0f / extent;
+
+    std::vector<std::pair<uint64_t, Index>> keyed(n);
+    for (Index v = 0; v < n; ++v) {
+        uint32_t x = (uint32_t)((positions[v].x - minX) * cell);
+        uint32_t y = (uint32_t)((positions[v].y - minY) * cell);
+        keyed[v] = { hilbertIndex(std::min(x, 65535u), std::min(y, 65535u)), v };
+    }
+    std::sort(keyed.begin(), keyed.end());
+
+    std::vector<Index> sequence(n);
+    for (Index v = 0; v < n; ++v) sequence[v] = keyed[v].second;
+    return VertexOrder<Index>::fromSequence(std::move(sequence));
+}
+
+// Grafo com os vértices renumerados; a lista de cada vértice fica em ordem de id
+// novo, então o relaxamento percorre dist em sentido crescente
+template <typename W, typename Index>
+Graph<W, Index> permuteGraph(const Graph<W, Index>& graph, const VertexOrder<Index>& order) {
+    Index n = graph.numVertices();
+    Graph<W, Index> g;
+    g.offsets.assign((size_t)n + 1, 0);
+    for (Index v = 0; v < n; ++v) {
+        Index old = order.toOld[v];
+        g.offsets[(size_t)v + 1] = g.offsets[v] + (graph.offsets[(size_t)old + 1] - graph.offsets[old]);
+    }
+    g.targets.resize(graph.numEdges());
+    g.weights.resize(graph.numEdges());
+
+    std::vector<std::pair<Index, W>> row;
+    for (Index v = 0; v < n; ++v) {
+        Index old = order.toOld[v];
+        row.clear();
+        for (size_t e = graph.offsets[old]; e < graph.offsets[(size_t)old + 1]; ++e)
+            row.push_back({ order.toNew[graph.targets[e]], graph.weights[e] });
+        std::sort(row.begin(), row.end());
+        for (size_t i = 0; i < row.size(); ++i) {
+            g.targets[g.offsets[v] + i] = row[i].first;
+            g.weights[g.offsets[v] + i] = row[i].second;
+        }
+    }
+    return g;
+}
+
+#endif
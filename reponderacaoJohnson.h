@@ -0,0 +1,160 @@
+#ifndef REPONDERACAO_JOHNSON_H
+#define REPONDERACAO_JOHNSON_H
+
+// Pesos negativos pela reponderação de Johnson. Um SPFA (Bellman–Ford com fila) a
+// partir de uma origem virtual ligada a todos os vértices com peso 0 dá os potenciais
+// h(v) <= 0 ou encontra um ciclo negativo. Com eles, w'(u, v) = w(u, v) + h(u) - h(v)
+// é não negativo e preserva os caminhos mínimos: d(s, t) = d'(s, t) - h(s) + h(t).
+// O grafo reponderado vai para os motores que exigem pesos não negativos
+// (DijkstraEngine, BatchRunner, CompressedGraph, o A* do YenKShortest, DenseDijkstra);
+// allPairs() roda V Dijkstras em paralelo sobre ele, o que em grafos esparsos sai
+// muito mais barato que O(V³).
+
+#include <vector>
+#include <memory>
+#include <thread>
+#include <cstdint>
+#include <cstddef>
+#include <algorithm>
+#include <type_traits>
+#include "caminhoMinimo.h"
+#include "consultasLote.h"
+
+template <typename W, typename Index = uint32_t>
+class JohnsonReweighting {
+    static_assert(std::is_signed<W>::value, "pesos negativos precisam de um tipo com sinal");
+
+public:
+    typedef WeightTraits<W> Traits;
+    // Somas intermediárias (potencial + peso) sem estouro
+    typedef typename std::conditional<std::is_floating_point<W>::value, double, int64_t>::type Wide;
+
+    static constexpr size_t SOURCES_PER_TASK = 16; // origens que uma thread pega de cada vez em allPairs
+
+    explicit JohnsonReweighting(const Graph<W, Index>& graph) : graph(&graph) {}
+
+    // Calcula os potenciais; false se houver ciclo negativo (ver negativeCycle())
+    bool computePotentials() {
+        Index n = graph->numVertices();
+        potential.assign(n, 0);
+        parent.assign(n, noVertex<Index>());
+        cycle.clear();
+        std::vector<char> queued(n, 1);
+        // Fila circular: cada vértice está nela no máximo uma vez
+        std::vector<Index> queue((size_t)n + 1);
+        size_t head = 0, tail = n;
+        for (Index v = 0; v < n; ++v) queue[v] = v;
+        size_t sinceCheck = 0; // relaxações desde a última procura por ciclo
+
+        while (head != tail) {
+            Index u = queue[head];
+            head = head == n ? 0 : head + 1;
+            queued[u] = 0;
+            Wide hu = potential[u];
+            for (size_t e = graph->offsets[u]; e < graph->offsets[(size_t)u + 1]; ++e) {
+                Index v = graph->targets[e];
+                Wide candidate = hu + (Wide)graph->weights[e];
+                if (candidate >= potential[v]) continue;
+                potential[v] = candidate;
+                parent[v] = u;
+                // Todo ciclo nos predecessores é negativo, e com um ciclo negativo um deles
+                // acaba aparecendo. A procura custa O(n), então é feita a cada n relaxações.
+                if (++sinceCheck >= n) {
+                    sinceCheck = 0;
+                    if (findParentCycle()) return false;
+                }
+                if (!queued[v]) {
+                    queued[v] = 1;
+                    queue[tail] = v;
+                    tail = tail == n ? 0 : tail + 1;
+                }
+            }
+        }
+        return true;
+    }
+
+    // Em Wide: num caminho longo de pesos negativos h(v) pode não caber em W
+    const std::vector<Wide>& potentials() const { return potential; }
+
+    // Vértices de um ciclo negativo, na ordem das arestas (vazio se não há)
+    const std::vector<Index>& negativeCycle() const { return cycle; }
+
+    // Mesmo grafo com os pesos w + h(u) - h(v), todos >= 0 (depois de computePotentials).
+    // Pesos que não cabem em R saturam em infinito; se isso importar, use um R mais largo.
+    template <typename R = W>
+    Graph<R, Index> reweighted() const {
+        Graph<R, Index> result;
+        result.offsets = graph->offsets;
+        result.targets = graph->targets;
+        result.weights.resize(graph->numEdges());
+        for (Index u = 0; u < graph->numVertices(); ++u)
+            for (size_t e = graph->offsets[u]; e < graph->offsets[(size_t)u + 1]; ++e) {
+                Wide w = (Wide)graph->weights[e] + potential[u] - potential[graph->targets[e]];
+                w = std::max<Wide>(w, 0); // arredondamento em ponto flutuante
+                result.weights[e] = w < (Wide)WeightTraits<R>::infinity() ? (R)w : WeightTraits<R>::infinity();
+            }
+        return result;
+    }
+
+    // Distância no grafo original a partir da distância no reponderado, em Wide: somando
+    // pesos negativos ela pode ficar abaixo do menor W (infinito de Wide se inalcançável)
+    template <typename R>
+    Wide originalDistance(Index source, Index target, R reweightedDistance) const {
+        if (reweightedDistance == WeightTraits<R>::infinity()) return WeightTraits<Wide>::infinity();
+        return (Wide)reweightedDistance - potential[source] + potential[target];
+    }
+
+    // Todos os pares: distances[s * n + t] em Wide (infinito se inalcançável). Um Dijkstra
+    // por origem no grafo reponderado, com um motor por thread. Pesos e distâncias
+    // reponderados também em Wide: w + h(u) - h(v) pode passar do maior W.
+    void allPairs(std::vector<Wide>& distances, unsigned threads = 0) const {
+        Index n = graph->numVertices();
+        distances.assign((size_t)n * n, WeightTraits<Wide>::infinity());
+        Graph<Wide, Index> costs = reweighted<Wide>();
+        threads = threads ? threads : std::max(1u, std::thread::hardware_concurrency());
+
+        size_t tasks = ((size_t)n + SOURCES_PER_TASK - 1) / SOURCES_PER_TASK;
+        std::vector<std::unique_ptr<DijkstraEngine<Wide, Index>>> engines(threads); // criados pela própria thread
+        runTasks(threads, tasks, [&](unsigned t, size_t task) {
+            if (!engines[t]) engines[t].reset(new DijkstraEngine<Wide, Index>(costs));
+            DijkstraEngine<Wide, Index>& engine = *engines[t];
+            Index last = (Index)std::min<size_t>(n, (task + 1) * SOURCES_PER_TASK);
+            for (Index s = (Index)(task * SOURCES_PER_TASK); s < last; ++s) {
+                engine.run(s);
+                Wide* row = distances.data() + (size_t)s * n;
+                for (Index v = 0; v < n; ++v) row[v] = originalDistance(s, v, engine.distance(v));
+            }
+        });
+    }
+
+private:
+    // Ciclo no grafo de predecessores; cada vértice é visitado uma vez, marcado com o
+    // vértice em que a caminhada começou
+    bool findParentCycle() {
+        Index n = graph->numVertices();
+        std::vector<Index> walk(n, noVertex<Index>());
+        for (Index start = 0; start < n; ++start) {
+            Index v = start;
+            while (v != noVertex<Index>() && walk[v] == noVertex<Index>()) {
+                walk[v] = start;
+                v = parent[v];
+            }
+            if (v == noVertex<Index>() || walk[v] != start) continue;
+            Index u = v;
+            do {
+                cycle.push_back(u);
+                u = parent[u];
+            } while (u != v);
+            std::reverse(cycle.begin(), cycle.end());
+            return true;
+        }
+        return false;
+    }
+
+    const Graph<W, Index>* graph;
+    std::vector<Wide> potential;
+    std::vector<Index> parent; // predecessor de cada vértice no SPFA
+    std::vector<Index> cycle;
+};
+
+#endif
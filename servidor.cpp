@@ -0,0 +1,578 @@
+// Servidor de consultas de caminho mínimo para outros processos locais: carrega o
+// grafo uma vez e atende pedidos por um socket Unix (protocolo em protocoloConsultas.h).
+// Uma thread de E/S aceita conexões e lê os pedidos com poll(); as trabalhadoras
+// executam as consultas, cada uma com o próprio DijkstraEngine (e portanto o próprio
+// workspace) sobre o mesmo grafo, só de leitura. Um cliente pode mandar vários
+// pedidos sem esperar as respostas; com MAX_IN_FLIGHT pedidos pendentes numa conexão
+// a leitura dela para até as respostas saírem.
+// Cada trabalhadora também agrega as estatísticas das buscas (metricasConsultas.h);
+// com --metricas elas vão para um arquivo no formato do Prometheus, regravado a cada
+// segundo, e com --metricas-porta são servidas em http://127.0.0.1:porta/metrics.
+// Com --carga o programa é um cliente de teste: mantém N pedidos em voo, mede a
+// latência vista pelo cliente e imprime também a medida pelo servidor.
+//
+// uso: ./servidor <grafo.snap | grafo.txt> [-s socket] [-t threads] [--metricas arquivo] [--metricas-porta porta]
+//      ./servidor --carga [-s socket] [-n consultas] [-j em voo] [-c % com caminho] [-r semente]
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <atomic>
+#include <memory>
+#include <chrono>
+#include <random>
+#include <condition_variable>
+#include <csignal>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <netinet/in.h>
+#include "caminhoMinimo.h"
+#include "arquivoGrafo.h"
+#include "reordenacao.h"
+#include "histogramaLatencia.h"
+#include "metricasConsultas.h"
+#include "protocoloConsultas.h"
+
+using namespace std;
+
+typedef uint32_t Weight;
+typedef uint32_t VertexId;
+
+const size_t MAX_IN_FLIGHT = 4096; // pedidos pendentes por conexão antes de parar de ler
+
+struct Connection {
+    int fd;
+    string input;             // pedido incompleto do último read() (só a thread de E/S)
+    bool endOfInput = false;  // cliente fechou a escrita: fecha depois das respostas
+    atomic<size_t> inFlight{ 0 };
+
+    mutex outMutex;           // protege fd (fechamento), output e wantWrite
+    string output;            // respostas que ainda não couberam no socket
+    bool wantWrite = false;   // a thread de E/S envia o resto quando o socket liberar
+
+    explicit Connection(int fd) : fd(fd) {}
+};
+
+struct Job {
+    shared_ptr<Connection> connection;
+    QueryRequest request;
+    chrono::steady_clock::time_point received;
+};
+
+// Grafo renumerado para localidade (os ids do protocolo são os do arquivo)
+Graph<Weight, VertexId> graph;
+VertexOrder<VertexId> order;
+
+mutex jobMutex;
+condition_variable jobCv;
+deque<Job> jobs;
+bool stopping = false;
+
+int wakePipe[2] = { -1, -1 }; // trabalhadoras acordam a thread de E/S
+vector<unique_ptr<LatencyHistogram>> histograms; // um por trabalhadora
+vector<unique_ptr<QueryMetrics>> queryMetrics;   // idem
+volatile sig_atomic_t interrupted = 0;
+
+void onSignal(int) { interrupted = 1; }
+
+void wakeIo() {
+    char c = 1;
+    if (write(wakePipe[1], &c, 1) < 0) {} // pipe cheio: a thread de E/S já vai acordar
+}
+
+// Envia o que couber sem bloquear (outMutex travado); false se a conexão caiu
+bool flushOutput(Connection& c) {
+    size_t sent = 0;
+    bool ok = true;
+    while (sent < c.output.size()) {
+        ssize_t n = send(c.fd, c.output.data() + sent, c.output.size() - sent, MSG_NOSIGNAL);
+        if (n < 0 && errno == EINTR) continue;
+        if (n < 0) {
+            ok = errno == EAGAIN || errno == EWOULDBLOCK;
+            break;
+        }
+        sent += (size_t)n;
+    }
+    c.output.erase(0, sent);
+    return ok;
+}
+
+// Acrescenta uma resposta e tenta enviá-la; o que sobrar a thread de E/S envia
+void sendReply(Connection& c, const void* data, size_t size) {
+    lock_guard<mutex> lock(c.outMutex);
+    if (c.fd < 0) return; // cliente já desconectou
+    c.output.append((const char*)data, size);
+    if (c.wantWrite) return;
+    flushOutput(c);
+    if (!c.output.empty()) {
+        c.wantWrite = true;
+        wakeIo();
+    }
+}
+
+ServerStats collectStats(unsigned workers) {
+    LatencyHistogram total;
+    for (const auto& h : histograms) total.merge(*h);
+    return { graph.numVertices(), graph.numEdges(), workers, total.count(), total.percentile(0.50),
+             total.percentile(0.90), total.percentile(0.99), total.max() };
+}
+
+// Monta a resposta de um pedido em reply (cabeçalho + palavras)
+void answer(const QueryRequest& q, DijkstraEngine<Weight, VertexId>& engine, QueryMetrics& metrics,
+            vector<VertexId>& path, vector<uint32_t>& reply) {
+    QueryReply header = { q.id, STATUS_OK, 0, 0 };
+    VertexId n = graph.numVertices();
+    path.clear();
+    if (q.type == QUERY_STATS) {
+        ServerStats stats = collectStats((unsigned)histograms.size());
+        path.resize(sizeof(stats) / 4);
+        memcpy(path.data(), &stats, sizeof(stats));
+    } else if (q.type != QUERY_DISTANCE && q.type != QUERY_PATH) {
+        header.status = STATUS_BAD_REQUEST;
+    } else if (q.source >= n || q.target >= n) {
+        header.status = STATUS_BAD_VERTEX;
+    } else {
+        VertexId target = order.toNew[q.target];
+        engine.run(order.toNew[q.source], target);
+        metrics.record(engine.stats());
+        header.distance = narrowDistance<uint32_t>(engine.distance(target)); // o protocolo tem 32 bits
+        if (!engine.reached(target)) {
+            header.status = STATUS_UNREACHABLE;
+        } else if (q.type == QUERY_PATH) {
+            engine.buildPath(target, path);
+            order.mapToOld(path);
+        }
+    }
+    header.words = (uint32_t)path.size();
+    reply.resize(4 + path.size());
+    memcpy(reply.data(), &header, sizeof(header));
+    if (!path.empty()) memcpy(reply.data() + 4, path.data(), path.size() * 4);
+}
+
+void workerLoop(size_t index) {
+    DijkstraEngine<Weight, VertexId> engine(graph);
+    LatencyHistogram& histogram = *histograms[index];
+    QueryMetrics& metrics = *queryMetrics[index];
+    vector<VertexId> path;
+    vector<uint32_t> reply;
+    for (;;) {
+        Job job;
+        {
+            unique_lock<mutex> lock(jobMutex);
+            jobCv.wait(lock, [] { return stopping || !jobs.empty(); });
+            if (stopping) return; // pedidos ainda na fila são descartados
+            job = move(jobs.front());
+            jobs.pop_front();
+        }
+        answer(job.request, engine, metrics, path, reply);
+        Connection& c = *job.connection;
+        sendReply(c, reply.data(), reply.size() * 4);
+        // Acorda a E/S quando a conexão volta a aceitar pedidos ou pode ser fechada
+        size_t before = c.inFlight.fetch_sub(1);
+        if (before == MAX_IN_FLIGHT || before == 1) wakeIo();
+        histogram.record(
+            (uint64_t)chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - job.received).count());
+    }
+}
+
+// Lê os pedidos disponíveis e os põe na fila; false se a conexão caiu. Só lê o que
+// cabe até MAX_IN_FLIGHT pendentes: o resto fica no socket até as respostas saírem.
+bool readRequests(const shared_ptr<Connection>& c, vector<Job>& batch) {
+    char buffer[1 << 16];
+    size_t inFlight = c->inFlight.load();
+    size_t room = inFlight < MAX_IN_FLIGHT ? MAX_IN_FLIGHT - inFlight : 0;
+    size_t wanted = room * sizeof(QueryRequest);
+    ssize_t n = 1;
+    while (c->input.size() < wanted &&
+           (n = read(c->fd, buffer, min(sizeof(buffer), wanted - c->input.size()))) > 0)
+        c->input.append(buffer, (size_t)n);
+    if (n == 0) c->endOfInput = true;
+    else if (n < 0 && errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR) return false;
+
+    auto now = chrono::steady_clock::now();
+    size_t used = 0;
+    batch.clear();
+    for (; used + sizeof(QueryRequest) <= c->input.size() && batch.size() < room; used += sizeof(QueryRequest)) {
+        Job job = { c, {}, now };
+        memcpy(&job.request, c->input.data() + used, sizeof(QueryRequest));
+        batch.push_back(move(job));
+    }
+    c->input.erase(0, used);
+    if (batch.empty()) return true;
+
+    c->inFlight += batch.size();
+    {
+        lock_guard<mutex> lock(jobMutex);
+        for (Job& job : batch) jobs.push_back(move(job));
+    }
+    if (batch.size() == 1) jobCv.notify_one();
+    else jobCv.notify_all();
+    return true;
+}
+
+// Texto do Prometheus com a latência do servidor e as métricas das buscas
+string metricsText() {
+    LatencyHistogram latency;
+    QueryMetrics searches;
+    for (const auto& h : histograms) latency.merge(*h);
+    for (const auto& m : queryMetrics) searches.merge(*m);
+    string text = "# HELP shortest_path_vertices Vértices do grafo carregado.\n# TYPE shortest_path_vertices gauge\n"
+                  "shortest_path_vertices " + to_string(graph.numVertices()) + "\n";
+    appendPrometheusHistogram(text, "shortest_path_server_latency_seconds",
+                              "Do pedido lido à resposta enviada, incluindo a fila.", latency, 1e-9);
+    appendPrometheusMetrics(text, "shortest_path_query", searches);
+    return text;
+}
+
+// Exportação das métricas numa thread própria: regrava o arquivo a cada segundo e
+// responde a qualquer GET na porta local (uma conexão por vez; é um endpoint de coleta)
+atomic<bool> metricsStopping{ false };
+
+// Espera fd ficar pronto para events até deadline; false se o prazo acabar
+bool waitUntil(int fd, short events, chrono::steady_clock::time_point deadline) {
+    for (;;) {
+        auto left = chrono::duration_cast<chrono::milliseconds>(deadline - chrono::steady_clock::now()).count();
+        if (left <= 0) return false;
+        pollfd pfd = { fd, events, 0 };
+        int ready = poll(&pfd, 1, (int)left);
+        if (ready > 0) return true;
+        if (ready < 0 && errno != EINTR) return false;
+    }
+}
+
+// O cliente é não bloqueante e a requisição inteira (leitura e resposta) tem um só prazo
+// de 1 s: um cliente lento não segura a thread, que também regrava o arquivo
+void serveMetrics(int client) {
+    auto deadline = chrono::steady_clock::now() + chrono::seconds(1);
+    string request;
+    char buffer[1024];
+    while (request.find("\r\n\r\n") == string::npos && request.size() < 8192) {
+        ssize_t n = read(client, buffer, sizeof(buffer));
+        if (n > 0) request.append(buffer, (size_t)n);
+        else if (n < 0 && errno == EINTR) continue;
+        else if (n == 0 || errno != EAGAIN || !waitUntil(client, POLLIN, deadline)) break;
+    }
+    if (request.find("\r\n\r\n") == string::npos && request.size() < 8192) { // prazo esgotado ou conexão fechada
+        close(client);
+        return;
+    }
+    string body, status = "200 OK";
+    if (request.compare(0, 4, "GET ") == 0) body = metricsText();
+    else status = "405 Method Not Allowed";
+    string response = "HTTP/1.1 " + status + "\r\nContent-Type: text/plain; version=0.0.4; charset=utf-8\r\n"
+                      "Content-Length: " + to_string(body.size()) + "\r\nConnection: close\r\n\r\n" + body;
+    for (size_t sent = 0; sent < response.size();) {
+        ssize_t n = send(client, response.data() + sent, response.size() - sent, MSG_NOSIGNAL);
+        if (n > 0) sent += (size_t)n;
+        else if (n < 0 && errno == EINTR) continue;
+        else if (n == 0 || errno != EAGAIN || !waitUntil(client, POLLOUT, deadline)) break;
+    }
+    close(client);
+}
+
+void metricsLoop(string file, int listener) {
+    auto lastWrite = chrono::steady_clock::now();
+    bool warned = false;
+    while (!metricsStopping) {
+        pollfd pfd = { listener, POLLIN, 0 };
+        if (listener >= 0 && poll(&pfd, 1, 200) > 0) {
+            int client;
+            while ((client = accept4(listener, nullptr, nullptr, SOCK_NONBLOCK)) >= 0) serveMetrics(client);
+        } else if (listener < 0) {
+            this_thread::sleep_for(chrono::milliseconds(200));
+        }
+        if (!file.empty() && chrono::steady_clock::now() - lastWrite >= chrono::seconds(1)) {
+            lastWrite = chrono::steady_clock::now();
+            if (!writeMetricsFile(file, metricsText()) && !warned) {
+                cerr << "Erro: não foi possível gravar as métricas em " << file << endl;
+                warned = true;
+            }
+        }
+    }
+    if (!file.empty()) writeMetricsFile(file, metricsText()); // estado final
+}
+
+void closeConnection(Connection& c) {
+    lock_guard<mutex> lock(c.outMutex);
+    close(c.fd);
+    c.fd = -1;
+    c.output.clear();
+}
+
+int runServer(const string& graphFile, const string& socketPath, unsigned threads, const string& metricsFile,
+              int metricsPort) {
+    vector<Coordinate> positions;
+    auto t0 = chrono::steady_clock::now();
+    if (!loadGraph(graphFile, graph, positions)) return 1;
+    order = positions.size() == graph.numVertices() ? hilbertOrder(positions.data(), graph.numVertices())
+                                                    : rcmOrder(graph);
+    graph = permuteGraph(graph, order);
+    cout << "grafo: " << graph.numVertices() << " vértices, " << graph.numEdges() << " arestas, carregado em "
+         << chrono::duration<double>(chrono::steady_clock::now() - t0).count() << " s" << endl;
+
+    sockaddr_un address;
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    if (socketPath.size() >= sizeof(address.sun_path)) {
+        cerr << "Erro: caminho de socket longo demais: " << socketPath << endl;
+        return 1;
+    }
+    strcpy(address.sun_path, socketPath.c_str());
+    unlink(socketPath.c_str()); // socket deixado por uma execução anterior
+    int listener = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK, 0);
+    if (listener < 0 || bind(listener, (sockaddr*)&address, sizeof(address)) != 0 || listen(listener, 128) != 0 ||
+        pipe2(wakePipe, O_NONBLOCK) != 0) {
+        cerr << "Erro: não foi possível criar o socket " << socketPath << endl;
+        return 1;
+    }
+
+    struct sigaction action;
+    memset(&action, 0, sizeof(action));
+    action.sa_handler = onSignal;
+    sigaction(SIGINT, &action, nullptr);
+    sigaction(SIGTERM, &action, nullptr);
+    signal(SIGPIPE, SIG_IGN);
+
+    int metricsListener = -1;
+    if (metricsPort > 0) {
+        sockaddr_in local;
+        memset(&local, 0, sizeof(local));
+        local.sin_family = AF_INET;
+        local.sin_port = htons((uint16_t)metricsPort);
+        local.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        int reuse = 1;
+        metricsListener = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK, 0);
+        if (metricsListener >= 0) setsockopt(metricsListener, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+        if (metricsListener < 0 || bind(metricsListener, (sockaddr*)&local, sizeof(local)) != 0 ||
+            listen(metricsListener, 16) != 0) {
+            cerr << "Erro: não foi possível abrir a porta de métricas " << metricsPort << endl;
+            unlink(socketPath.c_str());
+            return 1;
+        }
+    }
+
+    vector<thread> workers;
+    for (unsigned i = 0; i < threads; ++i) {
+        histograms.emplace_back(new LatencyHistogram());
+        queryMetrics.emplace_back(new QueryMetrics());
+    }
+    for (unsigned i = 0; i < threads; ++i) workers.emplace_back(workerLoop, i);
+    thread metricsThread;
+    if (!metricsFile.empty() || metricsListener >= 0) metricsThread = thread(metricsLoop, metricsFile, metricsListener);
+    cout << "atendendo em " << socketPath << " com " << threads << " threads (Ctrl+C encerra)" << endl;
+    if (metricsListener >= 0) cout << "métricas em http://127.0.0.1:" << metricsPort << "/metrics" << endl;
+    auto start = chrono::steady_clock::now();
+
+    vector<shared_ptr<Connection>> connections;
+    vector<pollfd> fds;
+    vector<Job> batch;
+    while (!interrupted) {
+        fds.clear();
+        fds.push_back({ listener, POLLIN, 0 });
+        fds.push_back({ wakePipe[0], POLLIN, 0 });
+        for (const auto& c : connections) {
+            short events = !c->endOfInput && c->inFlight < MAX_IN_FLIGHT ? POLLIN : 0;
+            lock_guard<mutex> lock(c->outMutex);
+            if (c->wantWrite) events |= POLLOUT;
+            fds.push_back({ c->fd, events, 0 });
+        }
+        if (poll(fds.data(), fds.size(), 200) < 0 && errno != EINTR) break;
+
+        if (fds[1].revents & POLLIN) {
+            char drain[256];
+            while (read(wakePipe[0], drain, sizeof(drain)) > 0) {}
+        }
+        for (size_t i = 0; i < connections.size(); ++i) {
+            Connection& c = *connections[i];
+            short revents = fds[i + 2].revents;
+            bool alive = !(revents & (POLLERR | POLLHUP | POLLNVAL)) || (revents & POLLIN);
+            if (alive && (revents & POLLOUT)) {
+                lock_guard<mutex> lock(c.outMutex);
+                alive = flushOutput(c);
+                if (c.output.empty()) c.wantWrite = false;
+            }
+            if (alive && (revents & POLLIN)) alive = readRequests(connections[i], batch);
+            if (alive && c.endOfInput && c.inFlight == 0) {
+                lock_guard<mutex> lock(c.outMutex);
+                alive = c.wantWrite; // respostas ainda por enviar
+            }
+            if (!alive) closeConnection(c);
+        }
+        connections.erase(remove_if(connections.begin(), connections.end(),
+                                    [](const shared_ptr<Connection>& c) { return c->fd < 0; }),
+                          connections.end());
+        if (fds[0].revents & POLLIN) {
+            int client;
+            while ((client = accept4(listener, nullptr, nullptr, SOCK_NONBLOCK)) >= 0)
+                connections.push_back(make_shared<Connection>(client));
+        }
+    }
+
+    {
+        lock_guard<mutex> lock(jobMutex);
+        stopping = true;
+    }
+    jobCv.notify_all();
+    for (auto& w : workers) w.join();
+    metricsStopping = true;
+    if (metricsThread.joinable()) metricsThread.join();
+    if (metricsListener >= 0) close(metricsListener);
+    for (const auto& c : connections) closeConnection(*c);
+    close(listener);
+    close(wakePipe[0]);
+    close(wakePipe[1]);
+    unlink(socketPath.c_str());
+
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    ServerStats stats = collectStats(threads);
+    printf("\n%llu consultas em %.1f s (%.0f/s); latência no servidor (µs): p50 %.1f  p90 %.1f  p99 %.1f  max %.1f\n",
+           (unsigned long long)stats.queries, seconds, stats.queries / seconds, stats.p50 / 1e3, stats.p90 / 1e3,
+           stats.p99 / 1e3, stats.max / 1e3);
+    return 0;
+}
+
+// Cliente de teste: uma thread envia mantendo até window pedidos sem resposta e a
+// principal lê as respostas e mede a latência de cada uma
+int runLoad(const string& socketPath, uint32_t queries, uint32_t window, int pathPercent, uint64_t seed) {
+    sockaddr_un address;
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    strncpy(address.sun_path, socketPath.c_str(), sizeof(address.sun_path) - 1);
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0 || connect(fd, (sockaddr*)&address, sizeof(address)) != 0) {
+        cerr << "Erro: não foi possível conectar a " << socketPath << endl;
+        return 1;
+    }
+
+    auto requestStats = [fd](ServerStats& stats) {
+        QueryRequest request = { UINT32_MAX, QUERY_STATS, 0, 0 };
+        QueryReply reply;
+        return writeFully(fd, &request, sizeof(request)) && readFully(fd, &reply, sizeof(reply)) &&
+               reply.words * 4 == sizeof(stats) && readFully(fd, &stats, sizeof(stats));
+    };
+    ServerStats stats;
+    if (!requestStats(stats) || stats.vertices == 0) {
+        cerr << "Erro: resposta inválida do servidor" << endl;
+        return 1;
+    }
+
+    vector<chrono::steady_clock::time_point> sentAt(queries);
+    mutex windowMutex;
+    condition_variable windowCv;
+    uint32_t answered = 0;
+    bool failed = false;
+    auto start = chrono::steady_clock::now();
+
+    thread sender([&] {
+        mt19937_64 rng(seed);
+        vector<QueryRequest> requests;
+        for (uint32_t id = 0; id < queries;) {
+            uint32_t count;
+            {
+                unique_lock<mutex> lock(windowMutex);
+                windowCv.wait(lock, [&] { return failed || id - answered < window; });
+                if (failed) return;
+                count = min(window - (id - answered), queries - id);
+            }
+            requests.clear();
+            auto now = chrono::steady_clock::now();
+            for (uint32_t k = 0; k < count; ++k, ++id) {
+                uint32_t type = (int)(rng() % 100) < pathPercent ? QUERY_PATH : QUERY_DISTANCE;
+                requests.push_back({ id, type, (uint32_t)(rng() % stats.vertices), (uint32_t)(rng() % stats.vertices) });
+                sentAt[id] = now;
+            }
+            if (!writeFully(fd, requests.data(), requests.size() * sizeof(QueryRequest))) return;
+        }
+    });
+
+    LatencyHistogram latency;
+    uint64_t unreachable = 0, pathWords = 0;
+    vector<uint32_t> payload;
+    for (uint32_t r = 0; r < queries; ++r) {
+        QueryReply reply;
+        payload.resize(0);
+        bool ok = readFully(fd, &reply, sizeof(reply)) && reply.id < queries;
+        if (ok && reply.words) {
+            payload.resize(reply.words);
+            ok = readFully(fd, payload.data(), reply.words * 4);
+        }
+        if (!ok || (reply.status != STATUS_OK && reply.status != STATUS_UNREACHABLE)) {
+            cerr << "Erro: resposta inválida do servidor" << endl;
+            lock_guard<mutex> lock(windowMutex);
+            failed = true;
+            break;
+        }
+        latency.record((uint64_t)chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() -
+                                                                              sentAt[reply.id]).count());
+        unreachable += reply.status == STATUS_UNREACHABLE;
+        pathWords += reply.words;
+        {
+            lock_guard<mutex> lock(windowMutex);
+            ++answered;
+        }
+        windowCv.notify_one();
+    }
+    windowCv.notify_one();
+    if (failed) shutdown(fd, SHUT_RDWR); // desbloqueia o envio
+    sender.join();
+    if (failed) return 1;
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    printf("%u consultas em %.2f s (%.0f/s), %u em voo, %llu inalcançáveis, %.1f vértices por caminho\n", queries,
+           seconds, queries / seconds, window, (unsigned long long)unreachable,
+           (double)pathWords / max<uint64_t>(1, queries * pathPercent / 100));
+    printf("latência no cliente  (µs): p50 %.1f  p90 %.1f  p99 %.1f  max %.1f\n", latency.percentile(0.50) / 1e3,
+           latency.percentile(0.90) / 1e3, latency.percentile(0.99) / 1e3, latency.max() / 1e3);
+    if (requestStats(stats))
+        printf("latência no servidor (µs): p50 %.1f  p90 %.1f  p99 %.1f  max %.1f  (%llu consultas, %llu threads)\n",
+               stats.p50 / 1e3, stats.p90 / 1e3, stats.p99 / 1e3, stats.max / 1e3,
+               (unsigned long long)stats.queries, (unsigned long long)stats.workers);
+    close(fd);
+    return 0;
+}
+
+void printUsage() {
+    cerr << "uso: servidor <grafo.snap | grafo.txt> [-s socket] [-t threads] [--metricas arquivo] [--metricas-porta porta]\n"
+            "     servidor --carga [-s socket] [-n consultas] [-j em voo] [-c % com caminho] [-r semente]" << endl;
+}
+
+int main(int argc, char** argv) {
+    string graphFile, socketPath = "/tmp/caminhos.sock", metricsFile;
+    int metricsPort = 0;
+    bool load = false;
+    unsigned threads = max(1u, thread::hardware_concurrency());
+    uint32_t queries = 100000, window = 64;
+    int pathPercent = 0;
+    uint64_t seed = 42;
+    for (int i = 1; i < argc; ++i) {
+        string arg = argv[i];
+        if (arg == "--carga") load = true;
+        else if (arg == "-s" && i + 1 < argc) socketPath = argv[++i];
+        else if (arg == "-t" && i + 1 < argc) threads = (unsigned)max(1, atoi(argv[++i]));
+        else if (arg == "-n" && i + 1 < argc) queries = (uint32_t)strtoul(argv[++i], nullptr, 10);
+        else if (arg == "-j" && i + 1 < argc) window = (uint32_t)max(1, atoi(argv[++i]));
+        else if (arg == "-c" && i + 1 < argc) pathPercent = atoi(argv[++i]);
+        else if (arg == "-r" && i + 1 < argc) seed = strtoull(argv[++i], nullptr, 10);
+        else if (arg == "--metricas" && i + 1 < argc) metricsFile = argv[++i];
+        else if (arg == "--metricas-porta" && i + 1 < argc) metricsPort = atoi(argv[++i]);
+        else if (graphFile.empty() && arg[0] != '-') graphFile = arg;
+        else {
+            printUsage();
+            return 1;
+        }
+    }
+    if (load) return runLoad(socketPath, queries, window, pathPercent, seed);
+    if (graphFile.empty()) {
+        printUsage();
+        return 1;
+    }
+    return runServer(graphFile, socketPath, threads, metricsFile, metricsPort);
+}
@@ -1,37 +1,133 @@
 #include <iostream>
 #include <vector>
 #include <cmath>
+#include <algorithm>
+#include <memory>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <condition_variable>
+#include <chrono>
 #include <GL/glew.h>
 #include <GLFW/glfw3.h>
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtc/type_ptr.hpp>
+#include "caminhoMinimo.h"
+#include "dijkstraDenso.h"
+#include "buscaLargura.h"
+#include "kCaminhos.h"
+#include "reordenacao.h"
+#include "arquivoGrafo.h"
+#include "gravacaoEntrada.h"
+#include "alimentacaoPesos.h"
+#include "nivelDetalhe.h"
+#include "captura.h"
+#include "gerenciadorShaders.h"
 
 using namespace std;
 
 // Shaders
+// Vértices: um quad instanciado por vértice, com o disco definido por distância com sinal
 const char* vertexShaderSource = R"glsl(
     #version 330 core
-    layout (location = 0) in vec2 position;
+    layout (location = 0) in vec2 corner;   // -1..1
+    layout (location = 1) in vec2 center;
+    layout (location = 2) in vec4 color;
     uniform mat4 model;
     uniform mat4 projection;
+    uniform float radius;
+    out vec2 local;
+    flat out vec3 fillColor;
     void main() {
-        gl_Position = projection * model * vec4(position, 0.0, 1.0);
+        local = corner * 1.25; // margem para a borda suavizada
+        fillColor = color.rgb;
+        gl_Position = projection * model * vec4(center + local * radius, 0.0, 1.0);
     }
 )glsl";
 
 const char* fragmentShaderSource = R"glsl(
     #version 330 core
+    in vec2 local;
+    flat in vec3 fillColor;
     out vec4 FragColor;
-    uniform vec3 color;
+    uniform vec3 outlineColor;
+    uniform float outlineWidth; // fração do raio
     void main() {
-        FragColor = vec4(color, 1.0);
+        float dist = length(local) - 1.0; // distância com sinal até a borda, em raios
+        float aa = fwidth(dist);
+        float alpha = 1.0 - smoothstep(-aa, aa, dist);
+        if (alpha <= 0.0) discard;
+        float inside = 1.0 - smoothstep(-aa, aa, dist + outlineWidth);
+        FragColor = vec4(mix(outlineColor, fillColor, inside), alpha);
+    }
+)glsl";
+
+// Arestas: quads instanciados em espaço de tela com anti-aliasing no shader
+const char* edgeVertexShaderSource = R"glsl(
+    #version 330 core
+    layout (location = 0) in vec2 corner;    // x: 0/1 ao longo da aresta, y: -1/1 na largura
+    layout (location = 1) in uvec2 endpoints; // índices dos vértices no buffer de posições
+    layout (location = 3) in uint state;     // 0 normal, 1 caminho, 2 explorada, 3+ alternativas, 255 livre
+    uniform samplerBuffer positions;
+    uniform mat4 model;
+    uniform mat4 projection;
+    uniform vec2 viewport;
+    uniform float widths[8];
+    uniform vec3 colors[8];
+    out float edgeOffset;
+    flat out float halfWidth;
+    flat out vec3 edgeColor;
+    void main() {
+        if (state == 255u) { // slot livre: fora do volume de recorte
+            gl_Position = vec4(0.0, 0.0, 2.0, 1.0);
+            return;
+        }
+        vec2 endpointA = texelFetch(positions, int(endpoints.x)).xy;
+        vec2 endpointB = texelFetch(positions, int(endpoints.y)).xy;
+        vec4 clipA = projection * model * vec4(endpointA, 0.0, 1.0);
+        vec4 clipB = projection * model * vec4(endpointB, 0.0, 1.0);
+        vec2 screenA = clipA.xy * viewport * 0.5;
+        vec2 screenB = clipB.xy * viewport * 0.5;
+
+        vec2 dir = screenB - screenA;
+        float len = length(dir);
+        dir = len > 0.0 ? dir / len : vec2(1.0, 0.0);
+        vec2 normal = vec2(-dir.y, dir.x);
+
+        uint s = min(state, 7u);
+        halfWidth = widths[s] * 0.5;
+        float extent = halfWidth + 1.0; // 1 pixel extra para a borda suavizada
+        edgeOffset = corner.y * extent;
+        edgeColor = colors[s];
+
+        vec2 screenPos = mix(screenA, screenB, corner.x) + normal * edgeOffset;
+        gl_Position = vec4(screenPos * 2.0 / viewport, 0.0, 1.0);
+    }
+)glsl";
+
+const char* edgeFragmentShaderSource = R"glsl(
+    #version 330 core
+    in float edgeOffset;
+    flat in float halfWidth;
+    flat in vec3 edgeColor;
+    out vec4 FragColor;
+    void main() {
+        float alpha = clamp(halfWidth + 0.5 - abs(edgeOffset), 0.0, 1.0);
+        FragColor = vec4(edgeColor, alpha);
     }
 )glsl";
 
 #define MAX_VERTICES 100
+#define MAX_EDGES (MAX_VERTICES * MAX_VERTICES)
+#define MAX_EDIT_WEIGHT (INF / MAX_VERTICES - 1) // mantém qualquer caminho simples abaixo de INF
 #define INF 999999
-#define SEGMENTS 60
+#define VERTEX_RADIUS 15.0f
+#define MAX_EVENTS_PER_FRAME 2000
+#define ANIMATION_TIME_BUDGET 0.004 // segundos de busca por quadro
+#define REPLAY_FRAME_DT (1.0 / 60.0)  // passo fixo da reprodução de gravações
+#define TIMER_QUERIES 4               // quadros em voo antes de ler o tempo de GPU
+#define LOD_CELL_PIXELS 12.0f         // tamanho na tela das células de cluster (visão afastada)
 
 struct Vertex {
     int dist;
@@ -44,11 +140,26 @@ struct Point2D {
     Point2D(float x = 0, float y = 0) : x(x), y(y) {}
 };
 
+// Estado de cada aresta enviado à GPU (um byte por aresta)
+enum EdgeState : GLubyte { EDGE_NORMAL = 0, EDGE_ON_PATH = 1, EDGE_EXPLORED = 2, EDGE_ALTERNATIVE = 3, EDGE_FREE = 255 };
+#define MAX_ROUTES 6 // caminho mínimo + 5 alternativas (estados 3..7)
+
 // Variáveis globais
 int numVertices = 6;
 int graph[MAX_VERTICES][MAX_VERTICES] = {0};
 Vertex vertices[MAX_VERTICES];
 vector<int> shortestPath;
+vector<vector<int>> alternativePaths; // rotas alternativas em ordem de custo (sem a primeira)
+vector<int> highlightedPath;          // caminho atualmente marcado nas arestas
+vector<vector<int>> highlightedAlternatives;
+int numRoutes = 1;                    // quantas rotas pedir à consulta (tecla K)
+int edgeSlot[MAX_VERTICES][MAX_VERTICES]; // índice da instância da aresta (i, j) ou -1
+int numEdges = 0;                     // instâncias desenhadas (slots já usados, livres ou não)
+vector<int> freeEdgeSlots;            // slots de arestas removidas, reaproveitados primeiro
+vector<GLubyte> edgeStates;           // cópia na CPU do buffer de estados
+vector<bool> edgeExplored;
+vector<int> dirtyEdges;               // arestas cujo estado ainda não foi enviado
+vector<GLubyte> vertexColors;         // RGBA8 por vértice, espelho do vertexColorVBO
 Point2D vertexPositions[MAX_VERTICES];
 int windowWidth = 800, windowHeight = 600;
 int startVertex = 0;
@@ -62,27 +173,132 @@ bool rotating = false;
 bool scaling = false;
 bool translating = false;
 float viewSize = 500.0f; // Tamanho da área visível
+double cursorX = 0.0, cursorY = 0.0;
+
+// Edição do grafo (tecla E)
+bool editMode = false;
+int selectedVertex = -1;
+int selectedFrom = -1, selectedTo = -1; // aresta selecionada
 
 // OpenGL objects
 GLuint shaderProgram;
-GLuint lineVAO, lineVBO;
-GLuint pathVAO, pathVBO;
-GLuint circleVAO, circleVBO;
-
-// Função para compilar shaders
-GLuint compileShader(GLenum type, const char* source) {
-    GLuint shader = glCreateShader(type);
-    glShaderSource(shader, 1, &source, NULL);
-    glCompileShader(shader);
-    
-    GLint success;
-    glGetShaderiv(shader, GL_COMPILE_STATUS, &success);
-    if (!success) {
-        char infoLog[512];
-        glGetShaderInfoLog(shader, 512, NULL, infoLog);
-        cerr << "Erro de compilação do shader:\n" << infoLog << endl;
+GLuint edgeProgram;
+GLuint edgeVAO, edgeCornerVBO, edgeIndexVBO, edgeStateVBO;
+GLuint positionVBO, positionTexture; // posições dos vértices, uma entrada por vértice
+GLuint discVAO, discCornerVBO, vertexColorVBO;
+GLuint lodEdgeVAO, lodEdgeIndexVBO, lodEdgeStateVBO, lodPositionVBO, lodPositionTexture, lodDiscVAO, lodColorVBO;
+FrameCapture frameCapture; // captura de tela (P) e de vídeo (V), ver captura.h
+ShaderManager shaderManager(".cache_shaders"); // binários dos programas em cache, ver gerenciadorShaders.h
+int vertexProgramId, edgeProgramId;
+
+void reconstructPath(int target);
+void submitPathQuery(int start, int target);
+void cancelPathQueries();
+
+// Pega os programas do gerenciador e define os uniforms que não mudam por quadro;
+// chamada de novo quando um shader é recarregado
+void configurePrograms() {
+    shaderProgram = shaderManager.program(vertexProgramId);
+    edgeProgram = shaderManager.program(edgeProgramId);
+
+    glUseProgram(shaderProgram);
+    glUniform1f(glGetUniformLocation(shaderProgram, "radius"), VERTEX_RADIUS);
+    glUniform1f(glGetUniformLocation(shaderProgram, "outlineWidth"), 0.12f);
+    glUniform3f(glGetUniformLocation(shaderProgram, "outlineColor"), 0.2f, 0.2f, 0.2f);
+
+    // Larguras (pixels) e cores de cada estado de aresta: normal, caminho, explorada
+    // e as rotas alternativas 2 a 6
+    const float edgeWidths[8] = { 1.5f, 4.0f, 2.5f, 3.5f, 3.5f, 3.0f, 3.0f, 3.0f };
+    const float edgeColors[24] = {
+        0.5f, 0.5f, 0.5f,
+        1.0f, 0.0f, 0.0f,
+        1.0f, 0.6f, 0.2f,
+        0.1f, 0.4f, 0.9f,
+        0.1f, 0.7f, 0.3f,
+        0.6f, 0.3f, 0.8f,
+        0.0f, 0.7f, 0.7f,
+        0.8f, 0.4f, 0.6f,
+    };
+    glUseProgram(edgeProgram);
+    glUniform1fv(glGetUniformLocation(edgeProgram, "widths"), 8, edgeWidths);
+    glUniform3fv(glGetUniformLocation(edgeProgram, "colors"), 8, edgeColors);
+    glUniform1i(glGetUniformLocation(edgeProgram, "positions"), 0);
+}
+
+// Marca o estado de uma aresta; o envio à GPU acontece em flushEdgeStates()
+void setEdgeState(int from, int to, GLubyte state) {
+    if (edgeStates.empty()) return;
+    int e = edgeSlot[from][to];
+    if (e < 0 || edgeStates[e] == state) return;
+    edgeStates[e] = state;
+    dirtyEdges.push_back(e);
+}
+
+void markEdgeExplored(int from, int to) {
+    if (edgeStates.empty() || edgeSlot[from][to] < 0) return;
+    edgeExplored[edgeSlot[from][to]] = true;
+    if (edgeStates[edgeSlot[from][to]] == EDGE_NORMAL) setEdgeState(from, to, EDGE_EXPLORED);
+}
+
+void clearExploredEdges() {
+    if (edgeStates.empty()) return;
+    for (int i = 0; i < numVertices; ++i)
+        for (int j = 0; j < numVertices; ++j)
+            if (edgeSlot[i][j] >= 0 && edgeExplored[edgeSlot[i][j]]) {
+                edgeExplored[edgeSlot[i][j]] = false;
+                if (edgeStates[edgeSlot[i][j]] == EDGE_EXPLORED) setEdgeState(i, j, EDGE_NORMAL);
+            }
+}
+
+// Devolve as arestas de uma rota ao estado base (normal ou explorada)
+void clearRouteEdges(const vector<int>& route) {
+    for (size_t i = 0; i + 1 < route.size(); ++i) {
+        int e = edgeSlot[route[i]][route[i+1]];
+        if (e >= 0) setEdgeState(route[i], route[i+1], edgeExplored[e] ? EDGE_EXPLORED : EDGE_NORMAL);
+    }
+}
+
+void markRouteEdges(const vector<int>& route, GLubyte state) {
+    for (size_t i = 0; i + 1 < route.size(); ++i)
+        setEdgeState(route[i], route[i+1], state);
+}
+
+// Troca as arestas marcadas como rota apenas quando as rotas mudam.
+// As alternativas são marcadas da pior para a melhor, e o caminho mínimo por último,
+// então uma aresta compartilhada fica com a cor da rota de menor custo.
+void updatePathEdges() {
+    if (edgeStates.empty()) return;
+    if (shortestPath == highlightedPath && alternativePaths == highlightedAlternatives) return;
+
+    clearRouteEdges(highlightedPath);
+    for (const auto& route : highlightedAlternatives) clearRouteEdges(route);
+
+    for (size_t r = alternativePaths.size(); r-- > 0; )
+        markRouteEdges(alternativePaths[r], EDGE_ALTERNATIVE + min<size_t>(r, MAX_ROUTES - 2));
+    markRouteEdges(shortestPath, EDGE_ON_PATH);
+
+    highlightedPath = shortestPath;
+    highlightedAlternatives = alternativePaths;
+}
+
+// Envia os estados alterados com glBufferSubData, agrupando índices contíguos
+void flushEdgeStates() {
+    if (dirtyEdges.empty()) return;
+
+    sort(dirtyEdges.begin(), dirtyEdges.end());
+    dirtyEdges.erase(unique(dirtyEdges.begin(), dirtyEdges.end()), dirtyEdges.end());
+
+    glBindBuffer(GL_ARRAY_BUFFER, edgeStateVBO);
+    size_t first = 0;
+    while (first < dirtyEdges.size()) {
+        size_t last = first;
+        while (last + 1 < dirtyEdges.size() && dirtyEdges[last+1] == dirtyEdges[last] + 1) ++last;
+        int offset = dirtyEdges[first];
+        int count = dirtyEdges[last] - offset + 1;
+        glBufferSubData(GL_ARRAY_BUFFER, offset, count, &edgeStates[offset]);
+        first = last + 1;
     }
-    return shader;
+    dirtyEdges.clear();
 }
 
 // Função para encontrar o vértice com menor distância
@@ -99,30 +315,77 @@ int findMinDistanceVertex(Vertex vertices[], int numVertices) {
     return minIndex;
 }
 
-// Algoritmo de Dijkstra
-void dijkstra(int graph[MAX_VERTICES][MAX_VERTICES], int numVertices, int start) {
-    for (int i = 0; i < numVertices; ++i) {
-        vertices[i].dist = INF;
-        vertices[i].known = false;
-        vertices[i].path = -1;
+// Eventos produzidos pela busca passo a passo
+enum SearchEventType { EVENT_SETTLE, EVENT_RELAX };
+
+struct SearchEvent {
+    SearchEventType type;
+    int vertex;   // vértice fixado ou relaxado
+    int from;     // predecessor (-1 para a origem)
+    int dist;     // distância após o evento
+};
+
+// Dijkstra retomável: cada chamada a next() avança até o próximo evento
+struct DijkstraStepper {
+    int (*graph)[MAX_VERTICES] = nullptr;
+    Vertex* state = nullptr; // tabela dist/known/path usada pela busca
+    int numVertices = 0;
+    int settled = 0;
+    int current = -1; // vértice cujos vizinhos estão sendo relaxados
+    int scan = 0;     // próximo vizinho a examinar
+    bool done = true;
+
+    void reset(int g[MAX_VERTICES][MAX_VERTICES], int n, int start, Vertex* s = vertices) {
+        graph = g;
+        state = s;
+        numVertices = n;
+        for (int i = 0; i < n; ++i) {
+            state[i].dist = INF;
+            state[i].known = false;
+            state[i].path = -1;
+        }
+        state[start].dist = 0;
+        settled = 0;
+        current = -1;
+        scan = 0;
+        done = false;
     }
-    vertices[start].dist = 0;
 
-    for (int count = 0; count < numVertices - 1; ++count) {
-        int v = findMinDistanceVertex(vertices, numVertices);
-        if (v == -1) break;
-        
-        vertices[v].known = true;
+    bool next(SearchEvent& ev) {
+        while (!done) {
+            if (current == -1) {
+                int v = (settled < numVertices) ? findMinDistanceVertex(state, numVertices) : -1;
+                if (v == -1) {
+                    done = true;
+                    break;
+                }
+                state[v].known = true;
+                ++settled;
+                current = v;
+                scan = 0;
+                ev = { EVENT_SETTLE, v, state[v].path, state[v].dist };
+                return true;
+            }
 
-        for (int w = 0; w < numVertices; ++w) {
-            if (graph[v][w] != 0 && !vertices[w].known && 
-                vertices[v].dist + graph[v][w] < vertices[w].dist) {
-                vertices[w].dist = vertices[v].dist + graph[v][w];
-                vertices[w].path = v;
+            int v = current;
+            while (scan < numVertices) {
+                int w = scan++;
+                if (graph[v][w] != 0 && !state[w].known &&
+                    state[v].dist + graph[v][w] < state[w].dist) {
+                    state[w].dist = state[v].dist + graph[v][w];
+                    state[w].path = v;
+                    ev = { EVENT_RELAX, w, v, state[w].dist };
+                    return true;
+                }
             }
+            current = -1;
         }
+        return false;
     }
+};
 
+// Imprime a tabela de distâncias e caminhos
+void printDistances(int numVertices) {
     cout << "Vertice\tDistancia\tCaminho" << endl;
     for (int i = 0; i < numVertices; ++i) {
         cout << i << "\t" << vertices[i].dist << "\t\t";
@@ -136,9 +399,81 @@ void dijkstra(int graph[MAX_VERTICES][MAX_VERTICES], int numVertices, int start)
     }
 }
 
-// Calcula posições dos vértices em um círculo
+// Algoritmo de Dijkstra (executa o stepper até o fim)
+void dijkstra(int graph[MAX_VERTICES][MAX_VERTICES], int numVertices, int start) {
+    DijkstraStepper stepper;
+    stepper.reset(graph, numVertices, start);
+    SearchEvent ev;
+    while (stepper.next(ev)) {}
+
+    printDistances(numVertices);
+}
+
+// Animação passo a passo da busca
+DijkstraStepper animStepper;
+bool animating = false;
+bool animationPaused = false;
+float animationSpeed = 4.0f;   // eventos por segundo
+double animationCredit = 0.0;  // eventos acumulados ainda não consumidos
+bool replaying = false;        // reproduzindo uma gravação: passo fixo e sem limite de tempo real
+int lastEventVertex = -1;
+
+void startAnimation() {
+    animStepper.reset(graph, numVertices, startVertex);
+    animating = true;
+    animationPaused = false;
+    animationCredit = 0.0;
+    lastEventVertex = -1;
+    shortestPath.clear();
+    alternativePaths.clear();
+    cancelPathQueries();
+    clearExploredEdges();
+}
+
+void finishAnimation() {
+    animating = false;
+    lastEventVertex = -1;
+    printDistances(numVertices);
+    if (targetVertex != -1) submitPathQuery(startVertex, targetVertex);
+}
+
+// Consome um número limitado de eventos por quadro, sem estourar o orçamento de tempo
+void advanceAnimation(double dt) {
+    if (!animating || animationPaused) return;
+
+    animationCredit = min(animationCredit + animationSpeed * dt, (double)MAX_EVENTS_PER_FRAME);
+    int budget = (int)animationCredit;
+    double deadline = glfwGetTime() + ANIMATION_TIME_BUDGET;
+
+    SearchEvent ev;
+    int consumed = 0;
+    while (consumed < budget) {
+        if (!animStepper.next(ev)) {
+            finishAnimation();
+            break;
+        }
+        lastEventVertex = ev.vertex;
+        if (ev.type == EVENT_RELAX) markEdgeExplored(ev.from, ev.vertex);
+        ++consumed;
+        if ((consumed & 63) == 0 && !replaying && glfwGetTime() > deadline) break;
+    }
+    animationCredit -= consumed;
+    if (animating && targetVertex != -1) reconstructPath(targetVertex);
+}
+
+// Posições lidas do arquivo, normalizadas para [0, 1]² (vazio = vértices em círculo)
+vector<Coordinate> fileLayout;
+
+// Calcula posições dos vértices em um círculo (ou segundo o layout do arquivo)
 void calculateVertexPositions() {
     float radius = min(windowWidth, windowHeight) * 0.3f;
+    if (!fileLayout.empty()) {
+        for (int i = 0; i < numVertices; ++i) {
+            vertexPositions[i].x = (fileLayout[i].x - 0.5f) * 2 * radius;
+            vertexPositions[i].y = (fileLayout[i].y - 0.5f) * 2 * radius;
+        }
+        return;
+    }
     for (int i = 0; i < numVertices; ++i) {
         float ang = 2 * M_PI * i / numVertices;
         vertexPositions[i].x = radius * cos(ang);
@@ -146,87 +481,830 @@ void calculateVertexPositions() {
     }
 }
 
+// Monta o caminho origem -> destino seguindo os predecessores
+void buildPath(const Vertex* state, int target, vector<int>& out) {
+    out.clear();
+    if (state[target].dist == INF) return;
+
+    for (int current = target; current != -1; current = state[current].path)
+        out.push_back(current);
+    reverse(out.begin(), out.end());
+}
+
 // Reconstrói o caminho mais curto
 void reconstructPath(int target) {
-    shortestPath.clear();
-    if (vertices[target].dist == INF) return;
-    
-    int current = target;
-    while (current != -1) {
-        shortestPath.insert(shortestPath.begin(), current);
-        current = vertices[current].path;
+    buildPath(vertices, target, shortestPath);
+}
+
+// Consultas de caminho mínimo em segundo plano
+enum QueryKind { QUERY_PATH, QUERY_NEAREST, QUERY_KINDS };
+
+struct PathQuery {
+    uint64_t id;
+    QueryKind kind;
+    int start;
+    int target;
+    vector<int> sources; // origens da consulta QUERY_NEAREST
+    int routes;          // QUERY_PATH: número de rotas pedidas (Yen quando > 1)
+};
+
+// Tipos usados pelo motor de consultas (pesos da matriz são inteiros positivos)
+typedef uint32_t Weight;
+typedef uint32_t VertexId;
+
+// Níveis de detalhe (tecla L); refeitos quando o grafo muda
+ClusterHierarchy<VertexId> lodHierarchy;
+bool lodEnabled = true;
+bool lodDirty = true;
+size_t lodLevel = SIZE_MAX; // nível e estado atualmente nos buffers
+float lodT = -1.0f;
+vector<int> lodPath;
+int lodStart = -1, lodTarget = -1;
+vector<Coordinate> lodCenters;
+
+struct PathResult {
+    uint64_t id = 0;
+    int target = -1;
+    Weight dist = WeightTraits<Weight>::infinity();
+    vector<int> path;
+    vector<vector<int>> alternatives; // rotas 2..k quando pedidas
+    vector<int> nearest; // QUERY_NEAREST: índice da origem mais próxima de cada vértice (-1 se nenhuma)
+    vector<Weight> distances; // QUERY_PATH: distância de cada vértice; valores < dist são exatos
+};
+
+// Troca de resultados sem bloqueio entre a thread de consultas e a de renderização.
+// Cada lado possui um buffer exclusivo; o terceiro fica no meio e é trocado
+// atomicamente, com um bit indicando que há resultado novo para o render.
+struct ResultHandoff {
+    static const int FRESH = 4;
+
+    PathResult slots[3];
+    int backSlot = 0;        // só a thread de consultas escreve aqui
+    int frontSlot = 1;       // só a renderização lê daqui
+    atomic<int> middle{2};
+
+    PathResult& back() { return slots[backSlot]; }
+    const PathResult& front() const { return slots[frontSlot]; }
+
+    void publish() {
+        backSlot = middle.exchange(backSlot | FRESH, memory_order_acq_rel) & 3;
     }
+
+    bool consume() {
+        if (!(middle.load(memory_order_acquire) & FRESH)) return false;
+        frontSlot = middle.exchange(frontSlot, memory_order_acq_rel) & 3;
+        return true;
+    }
+};
+
+// Cada tipo de consulta tem sua fila de uma posição, seu id e sua troca de resultados,
+// para que uma consulta de caminho não cancele a de origem mais próxima e vice-versa
+ResultHandoff resultHandoff[QUERY_KINDS];
+atomic<uint64_t> latestQueryId[QUERY_KINDS]; // consultas com id menor estão obsoletas
+mutex queryMutex;
+condition_variable queryCv;
+PathQuery pendingQuery[QUERY_KINDS];
+bool hasPendingQuery[QUERY_KINDS] = { false, false };
+bool stopQueryWorker = false;
+uint64_t lastSubmittedId[QUERY_KINDS] = { 0, 0 };  // só a thread principal usa
+atomic<uint64_t> finishedQueryId[QUERY_KINDS];      // última consulta concluída ou cancelada
+thread queryWorker;
+Graph<Weight, VertexId> queryGraph; // cópia CSR da matriz usada pela thread de consultas
+VertexOrderKind queryOrderKind = ORDER_RCM; // renumeração dos vértices dentro dos motores
+VertexOrder<VertexId> queryOrder;           // ids da tela <-> ids de queryGraph
+bool useDenseEngine = false;        // grafo denso: usa o Dijkstra O(V²) vetorizado
+bool useBfsEngine = false;          // todos os pesos iguais: usa a busca em largura
+Weight unitWeight = 0;
+
+// Cópia do grafo enviada pela thread principal a cada edição (protegida por queryMutex)
+bool graphChanged = false;
+VertexId pendingVertexCount = 0;
+vector<Edge<Weight, VertexId>> pendingEdges;
+vector<Point2D> pendingPositions;
+
+// Origem mais próxima
+vector<int> facilities;      // vértices marcados como origem (Shift + número)
+vector<int> nearestFacility; // índice em facilities da origem mais próxima de cada vértice
+bool showNearest = false;
+
+// Distâncias da última consulta de caminho aplicada, usadas para decidir se uma
+// edição pode mudar a rota exibida sem refazer a consulta
+vector<Weight> pathDistances;
+Weight pathDistance = 0;
+bool pathResultCurrent = false; // a rota exibida responde à última consulta enviada
+bool distancesExact = false;    // pathDistances ainda vale para o grafo atual
+
+// Envia uma consulta; qualquer consulta anterior do mesmo tipo em andamento é cancelada
+void submitQuery(PathQuery query) {
+    query.id = latestQueryId[query.kind].fetch_add(1) + 1;
+    lastSubmittedId[query.kind] = query.id;
+    {
+        lock_guard<mutex> lock(queryMutex);
+        QueryKind kind = query.kind;
+        pendingQuery[kind] = move(query);
+        hasPendingQuery[kind] = true;
+    }
+    queryCv.notify_one();
+}
+
+void submitPathQuery(int start, int target) {
+    pathResultCurrent = false;
+    submitQuery({ 0, QUERY_PATH, start, target, {}, numRoutes });
+}
+
+void submitNearestQuery() {
+    if (facilities.empty()) {
+        latestQueryId[QUERY_NEAREST].fetch_add(1);
+        nearestFacility.clear();
+        return;
+    }
+    submitQuery({ 0, QUERY_NEAREST, -1, -1, facilities, 0 });
+}
+
+void cancelPathQueries() {
+    latestQueryId[QUERY_PATH].fetch_add(1);
+}
+
+// Envia o grafo atual para a thread de consultas, que refaz o CSR e os motores
+// antes de atender a próxima consulta
+void submitGraph() {
+    lodDirty = true;
+    vector<Edge<Weight, VertexId>> edges;
+    for (int i = 0; i < numVertices; ++i)
+        for (int j = 0; j < numVertices; ++j)
+            if (graph[i][j] != 0) edges.push_back({ (VertexId)i, (VertexId)j, (Weight)graph[i][j] });
+    {
+        lock_guard<mutex> lock(queryMutex);
+        pendingEdges.swap(edges);
+        pendingPositions.assign(vertexPositions, vertexPositions + numVertices);
+        pendingVertexCount = numVertices;
+        graphChanged = true;
+    }
+    queryCv.notify_one();
+}
+
+// Monta queryGraph (renumerado) e escolhe o motor; só a thread de consultas chama
+void rebuildQueryGraph(VertexId n, const vector<Edge<Weight, VertexId>>& edges, const vector<Point2D>& positions) {
+    queryGraph = Graph<Weight, VertexId>::fromEdges(n, edges);
+    switch (queryOrderKind) {
+        case ORDER_BFS: queryOrder = bfsOrder(queryGraph); break;
+        case ORDER_RCM: queryOrder = rcmOrder(queryGraph); break;
+        case ORDER_HILBERT: queryOrder = hilbertOrder(positions.data(), n); break;
+        default: queryOrder = VertexOrder<VertexId>::identity(n); break;
+    }
+    queryGraph = permuteGraph(queryGraph, queryOrder);
+    useBfsEngine = uniformWeight(queryGraph, unitWeight);
+    useDenseEngine = !useBfsEngine && queryGraph.numEdges() * 8 >= (size_t)n * n;
+}
+
+void queryWorkerLoop() {
+    unique_ptr<DijkstraEngine<Weight, VertexId>> engine;
+    unique_ptr<DenseDijkstra> denseEngine;
+    unique_ptr<BfsEngine<Weight, VertexId>> bfsEngine;
+    unique_ptr<YenKShortest<Weight, VertexId>> yen;
+    vector<Edge<Weight, VertexId>> edges;
+    vector<Point2D> positions;
+    vector<RankedPath<Weight, VertexId>> routes;
+    vector<VertexId> path;
+    vector<VertexId> sources;
+    QueryKind lastKind = QUERY_PATH;
+    uint64_t lastId = 0;
+
+    while (true) {
+        // A consulta anterior terminou (publicada, cancelada ou obsoleta)
+        if (lastId) finishedQueryId[lastKind].store(lastId, memory_order_release);
+
+        PathQuery query;
+        bool rebuild = false, hasQuery = false;
+        VertexId n = 0;
+        {
+            unique_lock<mutex> lock(queryMutex);
+            queryCv.wait(lock, [] {
+                return hasPendingQuery[QUERY_PATH] || hasPendingQuery[QUERY_NEAREST] || graphChanged || stopQueryWorker;
+            });
+            if (stopQueryWorker) return;
+            if (graphChanged) {
+                edges.swap(pendingEdges);
+                positions.swap(pendingPositions);
+                n = pendingVertexCount;
+                graphChanged = false;
+                rebuild = true;
+            }
+            if (hasPendingQuery[QUERY_PATH] || hasPendingQuery[QUERY_NEAREST]) {
+                QueryKind kind = hasPendingQuery[QUERY_PATH] ? QUERY_PATH : QUERY_NEAREST;
+                query = move(pendingQuery[kind]);
+                hasPendingQuery[kind] = false;
+                hasQuery = true;
+            }
+        }
+
+        // Grafo editado: refaz o CSR e os motores (consultas seguintes já usam o novo)
+        if (rebuild) {
+            rebuildQueryGraph(n, edges, positions);
+            engine.reset(new DijkstraEngine<Weight, VertexId>(queryGraph));
+            denseEngine.reset(new DenseDijkstra(useDenseEngine ? n : 0));
+            if (useDenseEngine)
+                for (const auto& e : edges)
+                    denseEngine->setEdge(queryOrder.toNew[e.from], queryOrder.toNew[e.to], e.weight);
+            bfsEngine.reset(new BfsEngine<Weight, VertexId>(queryGraph, unitWeight));
+            yen.reset(new YenKShortest<Weight, VertexId>(queryGraph));
+        }
+        if (!hasQuery) continue;
+        lastKind = query.kind;
+        lastId = query.id;
+
+        // Consulta feita antes de remover um vértice: os ids podem não existir mais
+        n = queryGraph.numVertices();
+        bool valid = query.start < (int)n && query.target < (int)n;
+        for (int s : query.sources) valid = valid && s < (int)n;
+        if (!valid) continue;
+
+        // Os motores usam os ids de queryGraph; os resultados voltam para os da tela
+        int start = query.start >= 0 ? (int)queryOrder.toNew[query.start] : -1;
+        int target = query.target >= 0 ? (int)queryOrder.toNew[query.target] : -1;
+
+        uint64_t id = query.id;
+        atomic<uint64_t>& latest = latestQueryId[query.kind];
+        auto cancelled = [id, &latest] { return latest.load(memory_order_relaxed) != id; };
+        PathResult& result = resultHandoff[query.kind].back();
+
+        if (query.kind == QUERY_NEAREST) {
+            sources.clear();
+            for (int s : query.sources) sources.push_back(queryOrder.toNew[s]);
+            if (!engine->runMultiSource(sources, nullptr, cancelled)) continue;
+            result.nearest.resize(n);
+            for (VertexId v = 0; v < n; ++v) {
+                VertexId owner = engine->nearestSource(queryOrder.toNew[v]);
+                result.nearest[v] = owner == noVertex<VertexId>() ? -1 : (int)owner;
+            }
+        } else if (useBfsEngine) {
+            if (!bfsEngine->run(start, target, cancelled)) continue;
+            result.dist = bfsEngine->distance(target);
+            bfsEngine->buildPath(target, path);
+            result.path.assign(path.begin(), path.end());
+            result.distances.resize(n);
+            for (VertexId v = 0; v < n; ++v) result.distances[v] = bfsEngine->distance(queryOrder.toNew[v]);
+        } else if (useDenseEngine) {
+            if (!denseEngine->run(start, target, cancelled)) continue;
+            auto denseDistance = [&](int v) {
+                return denseEngine->reached(v) ? (Weight)denseEngine->distance(v) : WeightTraits<Weight>::infinity();
+            };
+            result.dist = denseDistance(target);
+            denseEngine->buildPath(target, result.path);
+            result.distances.resize(n);
+            for (VertexId v = 0; v < n; ++v) result.distances[v] = denseDistance(queryOrder.toNew[v]);
+        } else {
+            if (!engine->run(start, target, cancelled)) continue;
+            result.dist = narrowDistance<Weight>(engine->distance(target));
+            engine->buildPath(target, path);
+            result.path.assign(path.begin(), path.end());
+            result.distances.resize(n);
+            for (VertexId v = 0; v < n; ++v)
+                result.distances[v] = narrowDistance<Weight>(engine->distance(queryOrder.toNew[v]));
+        }
+
+        if (query.kind == QUERY_PATH) queryOrder.mapToOld(result.path);
+        result.alternatives.clear();
+        if (query.kind == QUERY_PATH && query.routes > 1 && !result.path.empty()) {
+            // com empates a primeira rota do Yen pode diferir do caminho acima; usa a dele
+            if (!yen->run(start, target, query.routes, routes, cancelled)) continue;
+            result.path.assign(routes[0].vertices.begin(), routes[0].vertices.end());
+            for (size_t r = 1; r < routes.size(); ++r)
+                result.alternatives.emplace_back(routes[r].vertices.begin(), routes[r].vertices.end());
+            queryOrder.mapToOld(result.path);
+            for (auto& alternative : result.alternatives) queryOrder.mapToOld(alternative);
+        }
+        if (latest.load() != id) continue;
+
+        result.id = id;
+        result.target = query.target;
+        resultHandoff[query.kind].publish();
+    }
+}
+
+void startQueryWorker() {
+    submitGraph();
+    queryWorker = thread(queryWorkerLoop);
+}
+
+void stopQueryWorkerThread() {
+    {
+        lock_guard<mutex> lock(queryMutex);
+        stopQueryWorker = true;
+    }
+    queryCv.notify_one();
+    queryWorker.join();
+}
+
+// Aplica os resultados mais recentes publicados pela thread de consultas
+void pollPathResult() {
+    if (resultHandoff[QUERY_PATH].consume()) {
+        const PathResult& result = resultHandoff[QUERY_PATH].front();
+        if (result.id == latestQueryId[QUERY_PATH].load() && !animating) {
+            shortestPath = result.path;
+            alternativePaths = result.alternatives;
+            pathDistances = result.distances;
+            pathDistance = result.dist;
+            pathResultCurrent = true;
+            distancesExact = !pathDistances.empty();
+        }
+    }
+    if (resultHandoff[QUERY_NEAREST].consume()) {
+        const PathResult& result = resultHandoff[QUERY_NEAREST].front();
+        if (result.id == latestQueryId[QUERY_NEAREST].load()) nearestFacility = result.nearest;
+    }
+}
+
+// Alterna um vértice como origem da consulta de origem mais próxima
+void toggleFacility(int v) {
+    auto it = find(facilities.begin(), facilities.end(), v);
+    if (it == facilities.end()) facilities.push_back(v);
+    else facilities.erase(it);
+    nearestFacility.clear(); // os índices antigos podem apontar além de facilities
+    if (showNearest) submitNearestQuery();
+}
+
+// Reprodução: espera a thread de consultas terminar tudo o que já foi enviado, para
+// que cada resultado apareça sempre no mesmo quadro
+void waitForQueries() {
+    for (int k = 0; k < QUERY_KINDS; ++k)
+        while (finishedQueryId[k].load(memory_order_acquire) < lastSubmittedId[k]) this_thread::yield();
+}
+
+// Envia as posições dos vértices; mudar o layout não exige refazer as arestas
+void uploadVertexPositions() {
+    glBindBuffer(GL_ARRAY_BUFFER, positionVBO);
+    glBufferSubData(GL_ARRAY_BUFFER, 0, numVertices * sizeof(Point2D), vertexPositions);
 }
 
 // Inicializa buffers OpenGL
 void initBuffers() {
-    // Configuração dos vértices (círculos)
-    vector<float> circleVertices;
-    const int segments = SEGMENTS;
-    const float radius = 15.0f;
-    
-    // Adiciona o centro do círculo
-    circleVertices.push_back(0.0f);
-    circleVertices.push_back(0.0f);
+    // Posições dos vértices: lidas pelos discos como atributo e pelas arestas como buffer de textura
+    glGenBuffers(1, &positionVBO);
+    glBindBuffer(GL_ARRAY_BUFFER, positionVBO);
+    glBufferData(GL_ARRAY_BUFFER, MAX_VERTICES * sizeof(Point2D), NULL, GL_DYNAMIC_DRAW);
+    glGenTextures(1, &positionTexture);
+    glBindTexture(GL_TEXTURE_BUFFER, positionTexture);
+    glTexBuffer(GL_TEXTURE_BUFFER, GL_RG32F, positionVBO);
+    uploadVertexPositions();
+
+    // Configuração dos vértices (discos): um quad instanciado por vértice
+    const float discCorners[] = {
+        -1.0f, -1.0f,
+         1.0f, -1.0f,
+        -1.0f,  1.0f,
+         1.0f,  1.0f,
+    };
+
+    glGenVertexArrays(1, &discVAO);
+    glBindVertexArray(discVAO);
+
+    glGenBuffers(1, &discCornerVBO);
+    glBindBuffer(GL_ARRAY_BUFFER, discCornerVBO);
+    glBufferData(GL_ARRAY_BUFFER, sizeof(discCorners), discCorners, GL_STATIC_DRAW);
+    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 2 * sizeof(float), (void*)0);
+    glEnableVertexAttribArray(0);
+
+    glBindBuffer(GL_ARRAY_BUFFER, positionVBO);
+    glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, sizeof(Point2D), (void*)0);
+    glEnableVertexAttribArray(1);
+    glVertexAttribDivisor(1, 1);
+
+    vertexColors.assign(MAX_VERTICES * 4, 0);
+    glGenBuffers(1, &vertexColorVBO);
+    glBindBuffer(GL_ARRAY_BUFFER, vertexColorVBO);
+    glBufferData(GL_ARRAY_BUFFER, vertexColors.size(), vertexColors.data(), GL_DYNAMIC_DRAW);
+    glVertexAttribPointer(2, 4, GL_UNSIGNED_BYTE, GL_TRUE, 4, (void*)0);
+    glEnableVertexAttribArray(2);
+    glVertexAttribDivisor(2, 1);
     
-    for (int i = 0; i <= segments; ++i) {
-        float angle = 2.0f * M_PI * i / segments;
-        circleVertices.push_back(radius * cos(angle));
-        circleVertices.push_back(radius * sin(angle));
+    // Configuração das arestas: um quad (tira de 4 vértices) instanciado por aresta
+    const float corners[] = {
+        0.0f, -1.0f,
+        1.0f, -1.0f,
+        0.0f,  1.0f,
+        1.0f,  1.0f,
+    };
+
+    // Cada aresta guarda só o par de índices (8 bytes); as posições ficam em positionVBO.
+    // Os buffers têm espaço para MAX_EDGES: inserir ou remover uma aresta é trocar um slot.
+    vector<GLuint> edgeIndices(2 * MAX_EDGES, 0);
+    numEdges = 0;
+    freeEdgeSlots.clear();
+    for (int i = 0; i < MAX_VERTICES; ++i) {
+        for (int j = 0; j < MAX_VERTICES; ++j) {
+            edgeSlot[i][j] = -1;
+            if (i < numVertices && j < numVertices && graph[i][j] != 0) {
+                edgeIndices[2 * numEdges] = i;
+                edgeIndices[2 * numEdges + 1] = j;
+                edgeSlot[i][j] = numEdges++;
+            }
+        }
     }
-    
-    glGenVertexArrays(1, &circleVAO);
-    glGenBuffers(1, &circleVBO);
-    glBindVertexArray(circleVAO);
-    glBindBuffer(GL_ARRAY_BUFFER, circleVBO);
-    glBufferData(GL_ARRAY_BUFFER, circleVertices.size() * sizeof(float), circleVertices.data(), GL_STATIC_DRAW);
+    edgeStates.assign(MAX_EDGES, EDGE_FREE);
+    fill(edgeStates.begin(), edgeStates.begin() + numEdges, (GLubyte)EDGE_NORMAL);
+    edgeExplored.assign(MAX_EDGES, false);
+    highlightedPath.clear();
+    dirtyEdges.clear();
+
+    glGenVertexArrays(1, &edgeVAO);
+    glBindVertexArray(edgeVAO);
+
+    glGenBuffers(1, &edgeCornerVBO);
+    glBindBuffer(GL_ARRAY_BUFFER, edgeCornerVBO);
+    glBufferData(GL_ARRAY_BUFFER, sizeof(corners), corners, GL_STATIC_DRAW);
     glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 2 * sizeof(float), (void*)0);
     glEnableVertexAttribArray(0);
-    
-    // Configuração das arestas
-    vector<float> lineVertices;
+
+    glGenBuffers(1, &edgeIndexVBO);
+    glBindBuffer(GL_ARRAY_BUFFER, edgeIndexVBO);
+    glBufferData(GL_ARRAY_BUFFER, edgeIndices.size() * sizeof(GLuint), edgeIndices.data(), GL_DYNAMIC_DRAW);
+    glVertexAttribIPointer(1, 2, GL_UNSIGNED_INT, 2 * sizeof(GLuint), (void*)0);
+    glEnableVertexAttribArray(1);
+    glVertexAttribDivisor(1, 1);
+
+    glGenBuffers(1, &edgeStateVBO);
+    glBindBuffer(GL_ARRAY_BUFFER, edgeStateVBO);
+    glBufferData(GL_ARRAY_BUFFER, edgeStates.size(), edgeStates.data(), GL_DYNAMIC_DRAW);
+    glVertexAttribIPointer(3, 1, GL_UNSIGNED_BYTE, 1, (void*)0);
+    glEnableVertexAttribArray(3);
+    glVertexAttribDivisor(3, 1);
+}
+
+// Edição do grafo. Cada aresta ocupa um slot fixo dos buffers de instâncias; slots
+// de arestas removidas vão para freeEdgeSlots e ficam com EDGE_FREE (o shader os
+// descarta), então inserir ou remover uma aresta é um glBufferSubData de um slot.
+void writeEdgeEndpoints(int slot, int from, int to) {
+    GLuint endpoints[2] = { (GLuint)from, (GLuint)to };
+    glBindBuffer(GL_ARRAY_BUFFER, edgeIndexVBO);
+    glBufferSubData(GL_ARRAY_BUFFER, slot * sizeof(endpoints), sizeof(endpoints), endpoints);
+}
+
+void allocateEdgeSlot(int from, int to) {
+    int slot;
+    if (!freeEdgeSlots.empty()) {
+        slot = freeEdgeSlots.back();
+        freeEdgeSlots.pop_back();
+    } else {
+        slot = numEdges++;
+    }
+    edgeSlot[from][to] = slot;
+    edgeExplored[slot] = false;
+    writeEdgeEndpoints(slot, from, to);
+    setEdgeState(from, to, EDGE_NORMAL);
+}
+
+void releaseEdgeSlot(int from, int to) {
+    int slot = edgeSlot[from][to];
+    if (slot < 0) return;
+    setEdgeState(from, to, EDGE_FREE);
+    edgeSlot[from][to] = -1;
+    freeEdgeSlots.push_back(slot);
+}
+
+void uploadVertexPosition(int v) {
+    glBindBuffer(GL_ARRAY_BUFFER, positionVBO);
+    glBufferSubData(GL_ARRAY_BUFFER, v * sizeof(Point2D), sizeof(Point2D), &vertexPositions[v]);
+}
+
+bool routeUsesEdge(const vector<int>& route, int from, int to) {
+    for (size_t i = 0; i + 1 < route.size(); ++i)
+        if (route[i] == from && route[i+1] == to) return true;
+    return false;
+}
+
+// Decide se a aresta from -> to, com peso trocado de oldWeight para newWeight (0 =
+// ausente), pode mudar as rotas exibidas. Invariante de pathDistances: toda distância
+// menor que a do destino é exata (foi fixada antes da busca parar) e, nas demais, a
+// distância real também não é menor que a do destino; enquanto isso vale, uma aresta
+// mais barata só melhora o caminho se d(from) + peso < d(destino).
+bool routesAffected(int from, int to, int oldWeight, int newWeight) {
+    if (!pathResultCurrent) return true; // consulta ainda em andamento: refaz com o grafo novo
+    if (numRoutes > 1) return true;      // alternativas mudam com qualquer edição
+
+    if (oldWeight != 0 && (newWeight == 0 || newWeight > oldWeight)) {
+        // Ficou mais cara: só importa se estava na rota, mas outras distâncias podem ter subido
+        distancesExact = false;
+        return routeUsesEdge(shortestPath, from, to);
+    }
+    if (!distancesExact || from >= (int)pathDistances.size()) return true;
+    Weight fromDistance = pathDistances[from];
+    if (fromDistance == WeightTraits<Weight>::infinity() || fromDistance >= pathDistance) return false;
+    if (fromDistance + (Weight)newWeight >= pathDistance) return false;
+    return true;
+}
+
+// Refaz as consultas depois de uma edição (a animação recomeça no grafo novo)
+void refreshAfterEdit(bool pathAffected) {
+    submitGraph();
+    if (animating) {
+        startAnimation();
+        return;
+    }
+    if (showNearest) submitNearestQuery();
+    if (targetVertex != -1 && pathAffected) submitPathQuery(startVertex, targetVertex);
+}
+
+// Troca o peso de from -> to (0 remove a aresta) sem refazer as consultas;
+// devolve se a rota exibida pode ter mudado
+bool applyEdgeWeight(int from, int to, int weight) {
+    int old = graph[from][to];
+    graph[from][to] = weight;
+    if (old == 0) allocateEdgeSlot(from, to);
+    else if (weight == 0) releaseEdgeSlot(from, to);
+    return routesAffected(from, to, old, weight);
+}
+
+void setEdgeWeight(int from, int to, int weight) {
+    if (from == to || graph[from][to] == weight) return;
+    refreshAfterEdit(applyEdgeWeight(from, to, weight));
+}
+
+// Atualizações de peso ao vivo (--pesos): um lote por quadro, com uma só
+// reconstrução do grafo da thread de consultas
+WeightFeed weightFeed;
+vector<WeightUpdate> feedBatch;
+
+void applyWeightFeed() {
+    // A animação percorre a matriz em uso: os pesos esperam (agrupados) até ela terminar
+    if (!weightFeed.active() || animating) return;
+    weightFeed.drain(feedBatch);
+    if (feedBatch.empty()) return;
+
+    double now = WeightFeed::clock(), lag = 0.0;
+    size_t applied = 0, rejected = 0;
+    bool affected = false;
+    for (const WeightUpdate& u : feedBatch) {
+        lag = max(lag, now - u.receivedAt);
+        if (u.from >= (uint32_t)numVertices || u.to >= (uint32_t)numVertices || u.from == u.to ||
+            u.weight > (uint32_t)MAX_EDIT_WEIGHT) {
+            ++rejected;
+            continue;
+        }
+        if (graph[u.from][u.to] == (int)u.weight) continue;
+        affected = applyEdgeWeight(u.from, u.to, u.weight) || affected;
+        ++applied;
+    }
+    weightFeed.noteBatch(applied, rejected, lag * 1000.0);
+    if (applied > 0) refreshAfterEdit(affected);
+}
+
+void addVertex(Point2D p) {
+    if (numVertices >= MAX_VERTICES) {
+        cerr << "Erro: limite de " << MAX_VERTICES << " vértices" << endl;
+        return;
+    }
+    int v = numVertices++;
+    for (int i = 0; i < numVertices; ++i) graph[v][i] = graph[i][v] = 0;
+    vertexPositions[v] = p;
+    if (!fileLayout.empty()) {
+        float radius = min(windowWidth, windowHeight) * 0.3f;
+        fileLayout.push_back({ p.x / (2 * radius) + 0.5f, p.y / (2 * radius) + 0.5f });
+    }
+    uploadVertexPosition(v);
+    refreshAfterEdit(false); // vértice isolado não muda a rota
+}
+
+// Remove o vértice v; o último vértice passa a usar o id v
+void removeVertex(int v) {
+    if (v == startVertex) {
+        cerr << "Erro: o vértice de origem não pode ser removido" << endl;
+        return;
+    }
+    // Desfaz o destaque das rotas enquanto os slots ainda apontam para as arestas antigas
+    shortestPath.clear();
+    alternativePaths.clear();
+    updatePathEdges();
+
     for (int i = 0; i < numVertices; ++i) {
-        for (int j = 0; j < numVertices; ++j) {
-            if (graph[i][j] != 0) {
-                lineVertices.push_back(vertexPositions[i].x);
-                lineVertices.push_back(vertexPositions[i].y);
-                lineVertices.push_back(vertexPositions[j].x);
-                lineVertices.push_back(vertexPositions[j].y);
-            }
+        if (graph[v][i] != 0) releaseEdgeSlot(v, i);
+        if (graph[i][v] != 0) releaseEdgeSlot(i, v);
+        graph[v][i] = graph[i][v] = 0;
+    }
+
+    int last = numVertices - 1;
+    if (v != last) {
+        for (int i = 0; i < last; ++i) {
+            if (i == v) continue;
+            graph[v][i] = graph[last][i];
+            graph[i][v] = graph[i][last];
+            edgeSlot[v][i] = edgeSlot[last][i];
+            edgeSlot[i][v] = edgeSlot[i][last];
+            if (edgeSlot[v][i] >= 0) writeEdgeEndpoints(edgeSlot[v][i], v, i);
+            if (edgeSlot[i][v] >= 0) writeEdgeEndpoints(edgeSlot[i][v], i, v);
+            graph[last][i] = graph[i][last] = 0;
+            edgeSlot[last][i] = edgeSlot[i][last] = -1;
         }
+        vertexPositions[v] = vertexPositions[last];
+        if (!fileLayout.empty()) fileLayout[v] = fileLayout[last];
+        uploadVertexPosition(v);
     }
-    
-    glGenVertexArrays(1, &lineVAO);
-    glGenBuffers(1, &lineVBO);
-    glBindVertexArray(lineVAO);
-    glBindBuffer(GL_ARRAY_BUFFER, lineVBO);
-    glBufferData(GL_ARRAY_BUFFER, lineVertices.size() * sizeof(float), lineVertices.data(), GL_STATIC_DRAW);
+    if (!fileLayout.empty()) fileLayout.pop_back();
+    numVertices = last;
+
+    facilities.erase(remove(facilities.begin(), facilities.end(), v), facilities.end());
+    for (int& f : facilities)
+        if (f == last) f = v;
+    nearestFacility.clear();
+    if (targetVertex == v) targetVertex = -1;
+    else if (targetVertex == last) targetVertex = v;
+    if (startVertex == last) startVertex = v;
+    selectedVertex = selectedFrom = selectedTo = -1;
+    pathDistances.clear();
+    if (targetVertex == -1) cancelPathQueries();
+    refreshAfterEdit(true);
+}
+
+// Visão afastada: clusters e feixes de arestas (nivelDetalhe.h) em vez do grafo inteiro.
+// Usa os mesmos programas de shader, com buffers próprios.
+void initLodBuffers() {
+    glGenBuffers(1, &lodPositionVBO);
+    glGenTextures(1, &lodPositionTexture);
+    glBindBuffer(GL_ARRAY_BUFFER, lodPositionVBO);
+    glBindTexture(GL_TEXTURE_BUFFER, lodPositionTexture);
+    glTexBuffer(GL_TEXTURE_BUFFER, GL_RG32F, lodPositionVBO);
+
+    glGenVertexArrays(1, &lodDiscVAO);
+    glBindVertexArray(lodDiscVAO);
+    glBindBuffer(GL_ARRAY_BUFFER, discCornerVBO);
     glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 2 * sizeof(float), (void*)0);
     glEnableVertexAttribArray(0);
-    
-    // Buffer para caminho mais curto (atualizado dinamicamente)
-    glGenVertexArrays(1, &pathVAO);
-    glGenBuffers(1, &pathVBO);
-    glBindVertexArray(pathVAO);
-    glBindBuffer(GL_ARRAY_BUFFER, pathVBO);
+    glBindBuffer(GL_ARRAY_BUFFER, lodPositionVBO);
+    glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, sizeof(Coordinate), (void*)0);
+    glEnableVertexAttribArray(1);
+    glVertexAttribDivisor(1, 1);
+    glGenBuffers(1, &lodColorVBO);
+    glBindBuffer(GL_ARRAY_BUFFER, lodColorVBO);
+    glVertexAttribPointer(2, 4, GL_UNSIGNED_BYTE, GL_TRUE, 4, (void*)0);
+    glEnableVertexAttribArray(2);
+    glVertexAttribDivisor(2, 1);
+
+    glGenVertexArrays(1, &lodEdgeVAO);
+    glBindVertexArray(lodEdgeVAO);
+    glBindBuffer(GL_ARRAY_BUFFER, edgeCornerVBO);
     glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 2 * sizeof(float), (void*)0);
     glEnableVertexAttribArray(0);
+    glGenBuffers(1, &lodEdgeIndexVBO);
+    glBindBuffer(GL_ARRAY_BUFFER, lodEdgeIndexVBO);
+    glVertexAttribIPointer(1, 2, GL_UNSIGNED_INT, 2 * sizeof(GLuint), (void*)0);
+    glEnableVertexAttribArray(1);
+    glVertexAttribDivisor(1, 1);
+    glGenBuffers(1, &lodEdgeStateVBO);
+    glBindBuffer(GL_ARRAY_BUFFER, lodEdgeStateVBO);
+    glVertexAttribIPointer(3, 1, GL_UNSIGNED_BYTE, 1, (void*)0);
+    glEnableVertexAttribArray(3);
+    glVertexAttribDivisor(3, 1);
 }
 
-// Atualiza o buffer do caminho mais curto
-void updatePathBuffer() {
-    vector<float> pathVertices;
-    for (size_t i = 0; i < shortestPath.size() - 1; ++i) {
-        int from = shortestPath[i];
-        int to = shortestPath[i+1];
-        pathVertices.push_back(vertexPositions[from].x);
-        pathVertices.push_back(vertexPositions[from].y);
-        pathVertices.push_back(vertexPositions[to].x);
-        pathVertices.push_back(vertexPositions[to].y);
+// Escolhe o nível de detalhe para a escala atual; false = desenhar o grafo inteiro
+bool chooseLod(int width, int height, size_t& level, float& t) {
+    if (!lodEnabled) return false;
+    if (lodDirty) {
+        vector<Coordinate> positions(numVertices);
+        for (int i = 0; i < numVertices; ++i) positions[i] = { vertexPositions[i].x, vertexPositions[i].y };
+        lodHierarchy.build(Graph<Weight, VertexId>::fromMatrix(graph, numVertices), positions.data());
+        lodDirty = false;
+        lodLevel = SIZE_MAX;
+    }
+    float pixelsPerUnit = min(width, height) / viewSize * scale;
+    return lodHierarchy.chooseLevel(lodHierarchy.extent() * pixelsPerUnit, LOD_CELL_PIXELS, level, t);
+}
+
+// Envia os buffers do nível (feixes, cores, caminho) quando algo muda, e as posições
+// interpoladas quando t muda
+void updateLodBuffers(size_t level, float t) {
+    const ClusterHierarchy<VertexId>::Level& l = lodHierarchy.level(level);
+    bool levelChanged = level != lodLevel;
+    if (levelChanged) {
+        vector<GLuint> endpoints(2 * l.bundles.size());
+        for (size_t b = 0; b < l.bundles.size(); ++b) {
+            endpoints[2 * b] = l.bundleFrom(l.bundles[b]);
+            endpoints[2 * b + 1] = l.bundleTo(l.bundles[b]);
+        }
+        glBindBuffer(GL_ARRAY_BUFFER, lodEdgeIndexVBO);
+        glBufferData(GL_ARRAY_BUFFER, endpoints.size() * sizeof(GLuint), endpoints.data(), GL_DYNAMIC_DRAW);
+        lodLevel = level;
+        lodT = -1.0f;
+    }
+
+    // Feixes atravessados pelo caminho mínimo; cluster da origem e do destino
+    if (levelChanged || lodPath != shortestPath || lodStart != startVertex || lodTarget != targetVertex) {
+        vector<GLubyte> states(l.bundles.size(), EDGE_NORMAL);
+        for (size_t i = 0; i + 1 < shortestPath.size(); ++i) {
+            long b = lodHierarchy.findBundle(level, lodHierarchy.clusterOf(shortestPath[i], level),
+                                             lodHierarchy.clusterOf(shortestPath[i+1], level));
+            if (b >= 0) states[b] = EDGE_ON_PATH;
+        }
+        glBindBuffer(GL_ARRAY_BUFFER, lodEdgeStateVBO);
+        glBufferData(GL_ARRAY_BUFFER, states.size(), states.data(), GL_DYNAMIC_DRAW);
+
+        vector<GLubyte> colors(4 * l.centers.size());
+        for (size_t c = 0; c < l.centers.size(); ++c) {
+            colors[4*c] = 204; colors[4*c + 1] = 204; colors[4*c + 2] = 0; colors[4*c + 3] = 255;
+        }
+        auto paint = [&](int v, GLubyte r, GLubyte g, GLubyte b) {
+            size_t c = lodHierarchy.clusterOf(v, level);
+            colors[4*c] = r; colors[4*c + 1] = g; colors[4*c + 2] = b;
+        };
+        if (targetVertex != -1) paint(targetVertex, 0, 0, 255);
+        paint(startVertex, 0, 255, 0);
+        glBindBuffer(GL_ARRAY_BUFFER, lodColorVBO);
+        glBufferData(GL_ARRAY_BUFFER, colors.size(), colors.data(), GL_DYNAMIC_DRAW);
+        lodPath = shortestPath;
+        lodStart = startVertex;
+        lodTarget = targetVertex;
+    }
+
+    if (t != lodT) {
+        lodHierarchy.morphedCenters(level, t, lodCenters);
+        glBindBuffer(GL_ARRAY_BUFFER, lodPositionVBO);
+        glBufferData(GL_ARRAY_BUFFER, lodCenters.size() * sizeof(Coordinate), lodCenters.data(), GL_STREAM_DRAW);
+        lodT = t;
+    }
+}
+
+void renderClusters(const glm::mat4& projection, const glm::mat4& model, int width, int height, size_t level, float t) {
+    updateLodBuffers(level, t);
+    const ClusterHierarchy<VertexId>::Level& l = lodHierarchy.level(level);
+
+    glUseProgram(edgeProgram);
+    glUniformMatrix4fv(glGetUniformLocation(edgeProgram, "projection"), 1, GL_FALSE, glm::value_ptr(projection));
+    glUniformMatrix4fv(glGetUniformLocation(edgeProgram, "model"), 1, GL_FALSE, glm::value_ptr(model));
+    glUniform2f(glGetUniformLocation(edgeProgram, "viewport"), (float)width, (float)height);
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_BUFFER, lodPositionTexture);
+    glBindVertexArray(lodEdgeVAO);
+    glDrawArraysInstanced(GL_TRIANGLE_STRIP, 0, 4, l.bundles.size());
+
+    // Disco do tamanho da célula, crescendo até o da célula do nível acima quando t -> 0
+    float cell = lodHierarchy.extent() / l.resolution;
+    glUseProgram(shaderProgram);
+    glUniformMatrix4fv(glGetUniformLocation(shaderProgram, "projection"), 1, GL_FALSE, glm::value_ptr(projection));
+    glUniformMatrix4fv(glGetUniformLocation(shaderProgram, "model"), 1, GL_FALSE, glm::value_ptr(model));
+    glUniform1f(glGetUniformLocation(shaderProgram, "radius"), 0.3f * cell * (2.0f - t));
+    glBindVertexArray(lodDiscVAO);
+    glDrawArraysInstanced(GL_TRIANGLE_STRIP, 0, 4, l.centers.size());
+    glUniform1f(glGetUniformLocation(shaderProgram, "radius"), VERTEX_RADIUS);
+}
+
+// Cores das regiões de origem mais próxima
+const float facilityPalette[8][3] = {
+    { 0.90f, 0.10f, 0.10f }, { 0.10f, 0.45f, 0.90f }, { 0.20f, 0.70f, 0.20f }, { 0.60f, 0.30f, 0.80f },
+    { 1.00f, 0.55f, 0.00f }, { 0.00f, 0.70f, 0.70f }, { 0.80f, 0.40f, 0.60f }, { 0.50f, 0.50f, 0.10f },
+};
+
+// Cor de cada vértice conforme origem, destino e estado da animação
+void vertexColor(int i, float rgb[3]) {
+    float r, g, b;
+    if (editMode && i == selectedVertex) {
+        r = 1.0f; g = 0.0f; b = 1.0f;
+    } else if (showNearest && !animating && i < (int)nearestFacility.size()) {
+        int owner = nearestFacility[i];
+        if (owner < 0 || owner >= (int)facilities.size()) {
+            r = g = b = 0.7f; // não alcançado por nenhuma origem (ou resultado ainda antigo)
+        } else {
+            // a própria origem fica mais escura que a região
+            float shade = facilities[owner] == i ? 0.6f : 1.0f;
+            r = facilityPalette[owner % 8][0] * shade;
+            g = facilityPalette[owner % 8][1] * shade;
+            b = facilityPalette[owner % 8][2] * shade;
+        }
+    } else if (i == startVertex) {
+        r = 0.0f; g = 1.0f; b = 0.0f;
+    } else if (targetVertex != -1 && i == targetVertex) {
+        r = 0.0f; g = 0.0f; b = 1.0f;
+    } else if (animating && i == lastEventVertex) {
+        r = 1.0f; g = 0.0f; b = 0.0f;
+    } else if (animating && vertices[i].known) {
+        r = 1.0f; g = 0.5f; b = 0.0f; // fixados
+    } else if (animating && vertices[i].dist != INF) {
+        r = 0.4f; g = 0.8f; b = 1.0f; // fronteira
+    } else {
+        r = 0.8f; g = 0.8f; b = 0.0f;
+    }
+    rgb[0] = r; rgb[1] = g; rgb[2] = b;
+}
+
+// Recalcula as cores e envia o buffer só se alguma mudou
+void updateVertexColors() {
+    bool changed = false;
+    for (int i = 0; i < numVertices; ++i) {
+        float rgb[3];
+        vertexColor(i, rgb);
+        for (int c = 0; c < 3; ++c) {
+            GLubyte value = (GLubyte)(rgb[c] * 255.0f + 0.5f);
+            if (vertexColors[i*4 + c] != value) {
+                vertexColors[i*4 + c] = value;
+                changed = true;
+            }
+        }
+        vertexColors[i*4 + 3] = 255;
+    }
+
+    if (changed) {
+        glBindBuffer(GL_ARRAY_BUFFER, vertexColorVBO);
+        glBufferSubData(GL_ARRAY_BUFFER, 0, numVertices * 4, vertexColors.data());
     }
-    
-    glBindBuffer(GL_ARRAY_BUFFER, pathVBO);
-    glBufferData(GL_ARRAY_BUFFER, pathVertices.size() * sizeof(float), pathVertices.data(), GL_DYNAMIC_DRAW);
 }
 
 // Função para resetar a visualização
@@ -236,20 +1314,9 @@ void resetView() {
     angle = 0.0f;
 }
 
-// Função de renderização
-void render(GLFWwindow* window) {
-    glClearColor(1.0f, 1.0f, 1.0f, 1.0f);
-    glClear(GL_COLOR_BUFFER_BIT);
-    
-    // Obtém o aspect ratio atual
-    int width, height;
-    glfwGetFramebufferSize(window, &width, &height);
-    glViewport(0, 0, width, height);
-    
+// Projeção ortográfica adaptável e matriz de modelo (transformações da visualização)
+void viewMatrices(int width, int height, glm::mat4& projection, glm::mat4& model) {
     float aspect = (float)width / (float)height;
-    
-    // Configura projeção ortográfica adaptável
-    glm::mat4 projection;
     if (aspect >= 1.0) {
         projection = glm::ortho(
             -viewSize/2.0f * aspect, viewSize/2.0f * aspect,
@@ -261,50 +1328,117 @@ void render(GLFWwindow* window) {
             -viewSize/2.0f / aspect, viewSize/2.0f / aspect,
             -1.0f, 1.0f);
     }
-    
-    // Matriz de modelo (transformações)
-    glm::mat4 model = glm::mat4(1.0f);
+    model = glm::mat4(1.0f);
     model = glm::translate(model, glm::vec3(translate, 0.0f));
     model = glm::rotate(model, glm::radians(angle), glm::vec3(0.0f, 0.0f, 1.0f));
     model = glm::scale(model, glm::vec3(scale, scale, 1.0f));
-    
-    glUseProgram(shaderProgram);
-    glUniformMatrix4fv(glGetUniformLocation(shaderProgram, "projection"), 1, GL_FALSE, glm::value_ptr(projection));
-    glUniformMatrix4fv(glGetUniformLocation(shaderProgram, "model"), 1, GL_FALSE, glm::value_ptr(model));
-    
-    // Desenha arestas
-    glUniform3f(glGetUniformLocation(shaderProgram, "color"), 0.5f, 0.5f, 0.5f);
-    glBindVertexArray(lineVAO);
-    glDrawArrays(GL_LINES, 0, numVertices * numVertices * 2);
-    
-    // Desenha caminho mais curto
-    if (!shortestPath.empty()) {
-        updatePathBuffer();
-        glUniform3f(glGetUniformLocation(shaderProgram, "color"), 1.0f, 0.0f, 0.0f);
-        glLineWidth(3.0f);
-        glBindVertexArray(pathVAO);
-        glDrawArrays(GL_LINES, 0, shortestPath.size() * 2);
-        glLineWidth(1.0f);
-    }
-    
-    // Desenha vértices
-    glBindVertexArray(circleVAO);
+}
+
+// Posição do cursor nas coordenadas do grafo (inverso da projeção e do modelo)
+Point2D cursorToGraph() {
+    glm::mat4 projection, model;
+    viewMatrices(windowWidth, windowHeight, projection, model);
+    glm::vec4 ndc(2.0f * (float)cursorX / windowWidth - 1.0f, 1.0f - 2.0f * (float)cursorY / windowHeight, 0.0f, 1.0f);
+    glm::vec4 p = glm::inverse(projection * model) * ndc;
+    return Point2D(p.x, p.y);
+}
+
+// Vértice sob o ponto p (o mais próximo dentro do raio), ou -1
+int vertexAt(Point2D p) {
+    int best = -1;
+    float bestDist = VERTEX_RADIUS * VERTEX_RADIUS;
     for (int i = 0; i < numVertices; ++i) {
-        glm::mat4 vertexModel = glm::translate(model, glm::vec3(vertexPositions[i].x, vertexPositions[i].y, 0.0f));
-        glUniformMatrix4fv(glGetUniformLocation(shaderProgram, "model"), 1, GL_FALSE, glm::value_ptr(vertexModel));
-        
-        if (i == startVertex) {
-            glUniform3f(glGetUniformLocation(shaderProgram, "color"), 0.0f, 1.0f, 0.0f);
-        } else if (targetVertex != -1 && i == targetVertex) {
-            glUniform3f(glGetUniformLocation(shaderProgram, "color"), 0.0f, 0.0f, 1.0f);
-        } else {
-            glUniform3f(glGetUniformLocation(shaderProgram, "color"), 0.8f, 0.8f, 0.0f);
+        float dx = vertexPositions[i].x - p.x, dy = vertexPositions[i].y - p.y;
+        if (dx * dx + dy * dy <= bestDist) {
+            bestDist = dx * dx + dy * dy;
+            best = i;
         }
-        
-        glDrawArrays(GL_TRIANGLE_FAN, 0, SEGMENTS + 2); // 30 segmentos + centro + fechamento
     }
+    return best;
+}
+
+// Clique no modo de edição: espaço vazio cria um vértice; dois vértices seguidos
+// criam (ou selecionam) a aresta entre eles
+void editClick() {
+    Point2D p = cursorToGraph();
+    int v = vertexAt(p);
+    if (v < 0) {
+        selectedVertex = selectedFrom = selectedTo = -1;
+        addVertex(p);
+        return;
+    }
+    if (selectedVertex < 0 || selectedVertex == v) {
+        selectedVertex = selectedVertex == v ? -1 : v;
+        selectedFrom = selectedTo = -1;
+        return;
+    }
+    selectedFrom = selectedVertex;
+    selectedTo = v;
+    selectedVertex = -1;
+    if (graph[selectedFrom][selectedTo] == 0) setEdgeWeight(selectedFrom, selectedTo, 1);
+    cout << "Aresta " << selectedFrom << " -> " << selectedTo << ": peso " << graph[selectedFrom][selectedTo] << endl;
+}
+
+void changeSelectedWeight(int delta) {
+    if (selectedFrom < 0 || graph[selectedFrom][selectedTo] == 0) return; // removida pelo --pesos
+    int weight = max(1, min(MAX_EDIT_WEIGHT, graph[selectedFrom][selectedTo] + delta));
+    setEdgeWeight(selectedFrom, selectedTo, weight);
+    cout << "Aresta " << selectedFrom << " -> " << selectedTo << ": peso " << weight << endl;
+}
+
+void deleteSelection() {
+    if (selectedFrom >= 0) {
+        setEdgeWeight(selectedFrom, selectedTo, 0);
+        cout << "Aresta " << selectedFrom << " -> " << selectedTo << " removida" << endl;
+        selectedFrom = selectedTo = -1;
+    } else if (selectedVertex >= 0) {
+        removeVertex(selectedVertex);
+    }
+}
+
+// Função de renderização
+void render(GLFWwindow* window) {
+    glClearColor(1.0f, 1.0f, 1.0f, 1.0f);
+    glClear(GL_COLOR_BUFFER_BIT);
+    
+    // Obtém o aspect ratio atual
+    int width, height;
+    glfwGetFramebufferSize(window, &width, &height);
+    glViewport(0, 0, width, height);
+
+    glm::mat4 projection, model;
+    viewMatrices(width, height, projection, model);
+
+    // Visão afastada: clusters em vez de discos e arestas abaixo de um pixel
+    size_t level;
+    float t;
+    if (chooseLod(width, height, level, t)) {
+        updatePathEdges();
+        flushEdgeStates();
+        renderClusters(projection, model, width, height, level, t);
+        return;
+    }
+    
+    // Desenha arestas (o caminho mais curto vem do estado de cada aresta)
+    updatePathEdges();
+    flushEdgeStates();
+    glUseProgram(edgeProgram);
+    glUniformMatrix4fv(glGetUniformLocation(edgeProgram, "projection"), 1, GL_FALSE, glm::value_ptr(projection));
+    glUniformMatrix4fv(glGetUniformLocation(edgeProgram, "model"), 1, GL_FALSE, glm::value_ptr(model));
+    glUniform2f(glGetUniformLocation(edgeProgram, "viewport"), (float)width, (float)height);
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_BUFFER, positionTexture);
+    glBindVertexArray(edgeVAO);
+    glDrawArraysInstanced(GL_TRIANGLE_STRIP, 0, 4, numEdges);
+    
+    glUseProgram(shaderProgram);
+    glUniformMatrix4fv(glGetUniformLocation(shaderProgram, "projection"), 1, GL_FALSE, glm::value_ptr(projection));
     
-    glfwSwapBuffers(window);
+    // Desenha vértices: um único draw instanciado
+    updateVertexColors();
+    glUniformMatrix4fv(glGetUniformLocation(shaderProgram, "model"), 1, GL_FALSE, glm::value_ptr(model));
+    glBindVertexArray(discVAO);
+    glDrawArraysInstanced(GL_TRIANGLE_STRIP, 0, 4, numVertices);
 }
 
 // Callbacks de teclado
@@ -325,11 +1459,46 @@ void keyCallback(GLFWwindow* window, int key, int scancode, int action, int mods
             case GLFW_KEY_END: angle -= rotationStep; break;
             case GLFW_KEY_ESCAPE: glfwSetWindowShouldClose(window, GLFW_TRUE); break;
             case GLFW_KEY_R: resetView(); break; // Resetar visualização
+            case GLFW_KEY_K: // Alternar entre 1, 3 e 6 rotas
+                numRoutes = numRoutes == 1 ? 3 : (numRoutes == 3 ? MAX_ROUTES : 1);
+                if (targetVertex != -1 && !animating) submitPathQuery(startVertex, targetVertex);
+                break;
+            case GLFW_KEY_P: if (action == GLFW_PRESS) frameCapture.requestScreenshot(); break;
+            case GLFW_KEY_V: if (action == GLFW_PRESS) frameCapture.toggleRecording(); break;
+            case GLFW_KEY_L: // Níveis de detalhe na visão afastada
+                lodEnabled = !lodEnabled;
+                cout << (lodEnabled ? "Níveis de detalhe ativados" : "Níveis de detalhe desativados") << endl;
+                break;
+            case GLFW_KEY_N: // Colorir por origem mais próxima
+                showNearest = !showNearest;
+                if (showNearest) submitNearestQuery();
+                break;
+            case GLFW_KEY_A: startAnimation(); break; // Reiniciar animação
+            case GLFW_KEY_SPACE: animationPaused = !animationPaused; break;
+            case GLFW_KEY_F: if (animating) { SearchEvent ev; while (animStepper.next(ev)) {} finishAnimation(); } break;
+            case GLFW_KEY_EQUAL:
+            case GLFW_KEY_KP_ADD: animationSpeed = min(animationSpeed * 2.0f, 100000.0f); break;
+            case GLFW_KEY_MINUS:
+            case GLFW_KEY_KP_SUBTRACT: animationSpeed = max(animationSpeed * 0.5f, 0.25f); break;
+            case GLFW_KEY_E: // Modo de edição
+                editMode = !editMode;
+                selectedVertex = selectedFrom = selectedTo = -1;
+                cout << (editMode ? "Modo de edição ativado" : "Modo de edição desativado") << endl;
+                break;
+            case GLFW_KEY_LEFT_BRACKET: if (editMode) changeSelectedWeight(-1); break;
+            case GLFW_KEY_RIGHT_BRACKET: if (editMode) changeSelectedWeight(1); break;
+            case GLFW_KEY_DELETE:
+            case GLFW_KEY_BACKSPACE: if (editMode && action == GLFW_PRESS) deleteSelection(); break;
         }
         
-        if (key >= GLFW_KEY_0 && key <= GLFW_KEY_5) {
+        if (key >= GLFW_KEY_0 && key <= GLFW_KEY_5 && key - GLFW_KEY_0 >= numVertices) {
+            // vértice inexistente (grafo editado)
+        } else if (key >= GLFW_KEY_0 && key <= GLFW_KEY_5 && (mods & GLFW_MOD_SHIFT)) {
+            toggleFacility(key - GLFW_KEY_0);
+        } else if (key >= GLFW_KEY_0 && key <= GLFW_KEY_5) {
             targetVertex = key - GLFW_KEY_0;
-            reconstructPath(targetVertex);
+            if (animating) reconstructPath(targetVertex);
+            else submitPathQuery(startVertex, targetVertex);
         }
     }
 }
@@ -337,7 +1506,8 @@ void keyCallback(GLFWwindow* window, int key, int scancode, int action, int mods
 // Callbacks de mouse
 void mouseButtonCallback(GLFWwindow* window, int button, int action, int mods) {
     if (action == GLFW_PRESS) {
-        if (button == GLFW_MOUSE_BUTTON_LEFT) rotating = true;
+        if (button == GLFW_MOUSE_BUTTON_LEFT && editMode) editClick();
+        else if (button == GLFW_MOUSE_BUTTON_LEFT) rotating = true;
         else if (button == GLFW_MOUSE_BUTTON_RIGHT) scaling = true;
         else if (button == GLFW_MOUSE_BUTTON_MIDDLE) translating = true;
     } else if (action == GLFW_RELEASE) {
@@ -349,6 +1519,8 @@ void mouseButtonCallback(GLFWwindow* window, int button, int action, int mods) {
 
 void cursorPosCallback(GLFWwindow* window, double xpos, double ypos) {
     static double prevX = xpos, prevY = ypos;
+    cursorX = xpos;
+    cursorY = ypos;
     double deltaX = xpos - prevX;
     double deltaY = ypos - prevY;
     
@@ -371,18 +1543,168 @@ void windowSizeCallback(GLFWwindow* window, int width, int height) {
     glViewport(0, 0, width, height);
 }
 
-int main() {
+// Gravação e reprodução de entradas (--gravar / --reproduzir)
+InputRecorder inputRecorder;
+InputTrace inputTrace;
+FrameLog frameLog;
+double inputClockStart = 0.0;
+
+double inputClock() {
+    return glfwGetTime() - inputClockStart;
+}
+
+// Callbacks registrados no GLFW: gravam a entrada (se pedido) e a repassam.
+// Durante a reprodução as entradas reais são ignoradas, exceto ESC.
+void keyInput(GLFWwindow* window, int key, int scancode, int action, int mods) {
+    if (replaying) {
+        if (key == GLFW_KEY_ESCAPE) glfwSetWindowShouldClose(window, GLFW_TRUE);
+        return;
+    }
+    inputRecorder.record({ inputClock(), INPUT_KEY, key, scancode, action, mods, 0.0, 0.0 });
+    keyCallback(window, key, scancode, action, mods);
+}
+
+void mouseButtonInput(GLFWwindow* window, int button, int action, int mods) {
+    if (replaying) return;
+    inputRecorder.record({ inputClock(), INPUT_MOUSE_BUTTON, button, action, mods, 0, 0.0, 0.0 });
+    mouseButtonCallback(window, button, action, mods);
+}
+
+void cursorPosInput(GLFWwindow* window, double xpos, double ypos) {
+    if (replaying) return;
+    inputRecorder.record({ inputClock(), INPUT_CURSOR, 0, 0, 0, 0, xpos, ypos });
+    cursorPosCallback(window, xpos, ypos);
+}
+
+void windowSizeInput(GLFWwindow* window, int width, int height) {
+    if (replaying) return; // a reprodução aplica o tamanho gravado
+    inputRecorder.record({ inputClock(), INPUT_RESIZE, width, height, 0, 0, 0.0, 0.0 });
+    windowSizeCallback(window, width, height);
+}
+
+// Repassa as entradas gravadas até o instante until; devolve quantas foram
+int replayInput(GLFWwindow* window, double until) {
+    InputEvent e;
+    int count = 0;
+    while (inputTrace.poll(until, e)) {
+        switch (e.type) {
+            case INPUT_KEY: keyCallback(window, e.a, e.b, e.c, e.d); break;
+            case INPUT_MOUSE_BUTTON: mouseButtonCallback(window, e.a, e.b, e.c); break;
+            case INPUT_CURSOR: cursorPosCallback(window, e.x, e.y); break;
+            case INPUT_RESIZE:
+                glfwSetWindowSize(window, e.a, e.b);
+                windowSizeCallback(window, e.a, e.b);
+                break;
+        }
+        ++count;
+    }
+    return count;
+}
+
+// Lê o tempo de GPU de um quadro já concluído
+void readFrameTimer(GLuint query, size_t frame) {
+    GLuint64 nanoseconds = 0;
+    glGetQueryObjectui64v(query, GL_QUERY_RESULT, &nanoseconds);
+    frameLog.setGpu(frame, nanoseconds / 1e6);
+}
+
+// Carrega um grafo do gerador (texto ou snapshot) na matriz de adjacência.
+// Arestas paralelas ficam com o menor peso.
+bool loadGraphFile(const string& fileName) {
+    Graph<Weight, VertexId> loaded;
+    vector<Coordinate> positions;
+    if (!loadGraph(fileName, loaded, positions)) return false;
+    if (loaded.numVertices() == 0 || loaded.numVertices() > MAX_VERTICES) {
+        cerr << "Erro: " << fileName << " tem " << loaded.numVertices() << " vértices (máximo " << MAX_VERTICES << ")" << endl;
+        return false;
+    }
+
+    numVertices = loaded.numVertices();
+    for (int i = 0; i < numVertices; ++i)
+        for (int j = 0; j < numVertices; ++j) graph[i][j] = 0;
+    for (int v = 0; v < numVertices; ++v)
+        for (size_t e = loaded.offsets[v]; e < loaded.offsets[v + 1]; ++e) {
+            int w = loaded.targets[e];
+            Weight weight = loaded.weights[e];
+            // Qualquer caminho simples precisa ficar abaixo de INF
+            if (weight == 0 || weight >= (Weight)(INF / numVertices) || w == v) {
+                cerr << "Erro: aresta " << v << " -> " << w << " com peso " << weight
+                     << " não suportado (use pesos entre 1 e " << INF / numVertices - 1 << ")" << endl;
+                return false;
+            }
+            if (graph[v][w] == 0 || (int)weight < graph[v][w]) graph[v][w] = weight;
+        }
+
+    // Layout do arquivo, centralizado e com a proporção preservada
+    fileLayout.clear();
+    if ((int)positions.size() == numVertices) {
+        float minX = positions[0].x, maxX = minX, minY = positions[0].y, maxY = minY;
+        for (const Coordinate& p : positions) {
+            minX = min(minX, p.x);
+            maxX = max(maxX, p.x);
+            minY = min(minY, p.y);
+            maxY = max(maxY, p.y);
+        }
+        float extent = max(max(maxX - minX, maxY - minY), 1e-6f);
+        if (maxX - minX > 0 || maxY - minY > 0) {
+            for (const Coordinate& p : positions)
+                fileLayout.push_back({ 0.5f + (p.x - (minX + maxX) / 2) / extent,
+                                       0.5f + (p.y - (minY + maxY) / 2) / extent });
+        }
+    }
+    return true;
+}
+
+int main(int argc, char** argv) {
+    auto launchTime = chrono::steady_clock::now(); // para o tempo até o primeiro quadro
+    // Grafo opcional vindo de arquivo (ver gerador.cpp); sem argumento usa o exemplo
+    string graphFile, recordFile, replayFile, timingFile, feedPath, shaderDir;
+    string capturePrefix = "captura";
+    CaptureFormat captureFormat = CAPTURE_PNG;
+    for (int i = 1; i < argc; ++i) {
+        string arg = argv[i];
+        if (arg == "--gravar" && i + 1 < argc) recordFile = argv[++i];
+        else if (arg == "--reproduzir" && i + 1 < argc) replayFile = argv[++i];
+        else if (arg == "--tempos" && i + 1 < argc) timingFile = argv[++i];
+        else if (arg == "--pesos" && i + 1 < argc) feedPath = argv[++i];
+        else if (arg == "--captura" && i + 1 < argc) capturePrefix = argv[++i];
+        else if (arg == "--video-bruto") captureFormat = CAPTURE_RAW;
+        else if (arg == "--shaders" && i + 1 < argc) shaderDir = argv[++i];
+        else if (graphFile.empty() && arg[0] != '-') graphFile = arg;
+        else {
+            cerr << "uso: saida [grafo] [--gravar entradas.txt] [--reproduzir entradas.txt] [--tempos quadros.csv] "
+                    "[--pesos fifo|socket] [--captura prefixo] [--video-bruto] [--shaders diretorio]" << endl;
+            return -1;
+        }
+    }
+    if (!graphFile.empty() && !loadGraphFile(graphFile)) return -1;
+    if (!replayFile.empty()) {
+        if (!recordFile.empty()) {
+            cerr << "Erro: --gravar e --reproduzir não podem ser usados juntos" << endl;
+            return -1;
+        }
+        if (!feedPath.empty()) {
+            cerr << "Erro: --pesos e --reproduzir não podem ser usados juntos (a reprodução seria diferente)" << endl;
+            return -1;
+        }
+        if (!inputTrace.load(replayFile)) return -1;
+        replaying = true;
+        if (inputTrace.width > 0 && inputTrace.height > 0) {
+            windowWidth = inputTrace.width;
+            windowHeight = inputTrace.height;
+        }
+    }
+
     // Inicializa GLFW
     if (!glfwInit()) {
         cerr << "Falha ao inicializar GLFW" << endl;
         return -1;
     }
 
-    // Configura contexto OpenGL e antialiasing
+    // Configura contexto OpenGL (antialiasing fica a cargo dos shaders)
     glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
     glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
     glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
-    glfwWindowHint(GLFW_SAMPLES, 4); // 4x MSAA
 
     GLFWwindow* window = glfwCreateWindow(windowWidth, windowHeight, "Dijkstra com OpenGL Moderno", NULL, NULL);
     if (!window) {
@@ -392,17 +1714,13 @@ int main() {
     }
 
     glfwMakeContextCurrent(window);
-    glfwSetWindowSizeCallback(window, windowSizeCallback);
+    glfwSetWindowSizeCallback(window, windowSizeInput);
+    if (replaying) glfwSwapInterval(0); // mede o custo real do quadro, sem esperar o vsync
 
-    // Ativa multisampling e blending
-    glEnable(GL_MULTISAMPLE);
+    // Ativa blending
     glEnable(GL_BLEND);
     glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
-    // Suavização opcional para linhas
-    glEnable(GL_LINE_SMOOTH);
-    glHint(GL_LINE_SMOOTH_HINT, GL_NICEST);
-
     // Inicializa GLEW
     glewExperimental = GL_TRUE;
     if (glewInit() != GLEW_OK) {
@@ -411,42 +1729,53 @@ int main() {
     }
 
     // Configura callbacks
-    glfwSetKeyCallback(window, keyCallback);
-    glfwSetMouseButtonCallback(window, mouseButtonCallback);
-    glfwSetCursorPosCallback(window, cursorPosCallback);
+    glfwSetKeyCallback(window, keyInput);
+    glfwSetMouseButtonCallback(window, mouseButtonInput);
+    glfwSetCursorPosCallback(window, cursorPosInput);
+    if (!recordFile.empty() && !inputRecorder.open(recordFile, windowWidth, windowHeight)) {
+        glfwTerminate();
+        return -1;
+    }
 
     // Configuração do grafo
-    graph[0][1] = 2; graph[0][2] = 8;
-    graph[1][2] = 5; graph[1][3] = 6;
-    graph[2][3] = 3; graph[2][4] = 2;
-    graph[3][4] = 1; graph[3][5] = 9;
-    graph[4][5] = 3;
+    if (graphFile.empty()) {
+        graph[0][1] = 2; graph[0][2] = 8;
+        graph[1][2] = 5; graph[1][3] = 6;
+        graph[2][3] = 3; graph[2][4] = 2;
+        graph[3][4] = 1; graph[3][5] = 9;
+        graph[4][5] = 3;
+    }
 
-    dijkstra(graph, numVertices, startVertex);
+    startAnimation();
     calculateVertexPositions();
 
-    // Compila shaders
-    GLuint vertexShader = compileShader(GL_VERTEX_SHADER, vertexShaderSource);
-    GLuint fragmentShader = compileShader(GL_FRAGMENT_SHADER, fragmentShaderSource);
-
-    shaderProgram = glCreateProgram();
-    glAttachShader(shaderProgram, vertexShader);
-    glAttachShader(shaderProgram, fragmentShader);
-    glLinkProgram(shaderProgram);
-
-    GLint success;
-    glGetProgramiv(shaderProgram, GL_LINK_STATUS, &success);
-    if (!success) {
-        char infoLog[512];
-        glGetProgramInfoLog(shaderProgram, 512, NULL, infoLog);
-        cerr << "Erro de linkagem do shader program:\n" << infoLog << endl;
-    }
-
-    glDeleteShader(vertexShader);
-    glDeleteShader(fragmentShader);
+    // Compila shaders (ou carrega do cache); o driver compila enquanto os buffers
+    // e a thread de consultas são preparados
+    vertexProgramId = shaderManager.add("vertices", vertexShaderSource, fragmentShaderSource);
+    edgeProgramId = shaderManager.add("arestas", edgeVertexShaderSource, edgeFragmentShaderSource);
+    if (!shaderDir.empty()) shaderManager.watch(shaderDir);
+    shaderManager.startBuild();
 
     // Configura buffers
     initBuffers();
+    initLodBuffers();
+    frameCapture.init(capturePrefix, captureFormat);
+    startQueryWorker();
+    if (!shaderManager.finishBuild()) {
+        // o log de compilação/linkagem já foi impresso; sem programa não há o que desenhar
+        cerr << "Erro: não foi possível montar os shaders" << endl;
+        frameCapture.shutdown();
+        stopQueryWorkerThread();
+        glfwTerminate();
+        return -1;
+    }
+    configurePrograms();
+    if (!feedPath.empty() && !weightFeed.start(feedPath)) {
+        frameCapture.shutdown(); // antes do glfwTerminate: libera os PBOs com o contexto ainda ativo
+        stopQueryWorkerThread();
+        glfwTerminate();
+        return -1;
+    }
 
     cout << "Controles:\n"
          << "0-5: Selecionar vértice destino\n"
@@ -454,23 +1783,122 @@ int main() {
          << "Page Up/Down: Zoom\n"
          << "Home/End: Rotacionar\n"
          << "R: Resetar visualização\n"
+         << "A: Reiniciar animação do Dijkstra\n"
+         << "Espaço: Pausar/continuar animação\n"
+         << "+/-: Velocidade da animação\n"
+         << "F: Concluir animação\n"
+         << "Shift+0-5: Marcar/desmarcar vértice como origem\n"
+         << "N: Colorir vértices pela origem mais próxima\n"
+         << "L: Agrupar vértices em clusters quando afastado\n"
+         << "P: Capturar a tela (PNG)\n"
+         << "V: Iniciar/parar gravação de vídeo\n"
+         << "K: Mostrar 1, 3 ou 6 rotas alternativas\n"
+         << "E: Modo de edição (clique: cria vértice / seleciona; dois vértices: cria aresta)\n"
+         << "[ / ]: Diminuir/aumentar o peso da aresta selecionada\n"
+         << "Delete: Remover a aresta ou o vértice selecionado\n"
          << "Mouse: Arrastar para rotacionar/zoom/mover\n"
          << "ESC: Sair\n";
 
+    // Tempo de GPU por quadro em anel de timer queries, lido TIMER_QUERIES quadros depois
+    bool logFrames = replaying || !timingFile.empty();
+    GLuint timerQueries[TIMER_QUERIES];
+    if (logFrames) glGenQueries(TIMER_QUERIES, timerQueries);
+
     // Loop principal
+    double lastTime = glfwGetTime();
+    double lastTitleTime = lastTime;
+    double lastShaderCheck = lastTime;
+    inputClockStart = lastTime;
+    size_t frame = 0;
     while (!glfwWindowShouldClose(window)) {
+        double frameStart = glfwGetTime();
         glfwPollEvents();
+        int events = 0;
+        double dt;
+        if (replaying) {
+            // Passo fixo: o quadro n recebe exatamente as entradas gravadas até (n + 1) * dt
+            double simulated = (frame + 1) * REPLAY_FRAME_DT;
+            events = replayInput(window, simulated);
+            waitForQueries();
+            dt = REPLAY_FRAME_DT;
+            if (inputTrace.finished(simulated)) glfwSetWindowShouldClose(window, GLFW_TRUE);
+        } else {
+            dt = frameStart - lastTime;
+            lastTime = frameStart;
+        }
+
+        double cpuStart = glfwGetTime();
+        if (logFrames) {
+            if (frame >= TIMER_QUERIES) readFrameTimer(timerQueries[frame % TIMER_QUERIES], frame - TIMER_QUERIES);
+            glBeginQuery(GL_TIME_ELAPSED, timerQueries[frame % TIMER_QUERIES]);
+        }
+        applyWeightFeed();
+        advanceAnimation(dt);
+        pollPathResult();
         render(window);
+        if (logFrames) glEndQuery(GL_TIME_ELAPSED);
+        int framebufferWidth, framebufferHeight;
+        glfwGetFramebufferSize(window, &framebufferWidth, &framebufferHeight);
+        frameCapture.capture(framebufferWidth, framebufferHeight);
+        double cpuEnd = glfwGetTime();
+        glfwSwapBuffers(window);
+        if (frame == 0) {
+            glFinish(); // o quadro só conta quando a GPU terminou de desenhá-lo
+            double ms = chrono::duration<double, milli>(chrono::steady_clock::now() - launchTime).count();
+            printf("primeiro quadro: %.1f ms desde o início\n", ms);
+            shaderManager.printReport();
+        }
+        if (logFrames) frameLog.add(events, (cpuEnd - cpuStart) * 1000.0, (glfwGetTime() - frameStart) * 1000.0);
+        ++frame;
+
+        // Atraso das atualizações de peso no título, uma vez por segundo
+        if (weightFeed.active() && frameStart - lastTitleTime >= 1.0) {
+            char title[128];
+            snprintf(title, sizeof(title), "Dijkstra com OpenGL Moderno - atraso dos pesos %.1f ms", weightFeed.lastLag());
+            glfwSetWindowTitle(window, title);
+            lastTitleTime = frameStart;
+        }
+
+        // Shaders editados em --shaders são recompilados, uma verificação por segundo
+        if (!shaderDir.empty() && frameStart - lastShaderCheck >= 1.0) {
+            if (shaderManager.reloadChanged()) configurePrograms();
+            lastShaderCheck = frameStart;
+        }
+    }
+
+    if (logFrames) {
+        for (size_t f = frame > TIMER_QUERIES ? frame - TIMER_QUERIES : 0; f < frame; ++f)
+            readFrameTimer(timerQueries[f % TIMER_QUERIES], f);
+        glDeleteQueries(TIMER_QUERIES, timerQueries);
+        frameLog.printSummary();
+        if (!timingFile.empty()) frameLog.write(timingFile);
+    }
+    inputRecorder.close(inputClock());
+    if (weightFeed.active()) {
+        weightFeed.stop();
+        weightFeed.printSummary();
     }
 
     // Limpeza
-    glDeleteVertexArrays(1, &lineVAO);
-    glDeleteBuffers(1, &lineVBO);
-    glDeleteVertexArrays(1, &pathVAO);
-    glDeleteBuffers(1, &pathVBO);
-    glDeleteVertexArrays(1, &circleVAO);
-    glDeleteBuffers(1, &circleVBO);
-    glDeleteProgram(shaderProgram);
+    frameCapture.shutdown();
+    stopQueryWorkerThread();
+    glDeleteVertexArrays(1, &edgeVAO);
+    glDeleteBuffers(1, &edgeCornerVBO);
+    glDeleteBuffers(1, &edgeIndexVBO);
+    glDeleteBuffers(1, &positionVBO);
+    glDeleteTextures(1, &positionTexture);
+    glDeleteBuffers(1, &edgeStateVBO);
+    glDeleteVertexArrays(1, &discVAO);
+    glDeleteBuffers(1, &discCornerVBO);
+    glDeleteBuffers(1, &vertexColorVBO);
+    glDeleteVertexArrays(1, &lodEdgeVAO);
+    glDeleteVertexArrays(1, &lodDiscVAO);
+    glDeleteBuffers(1, &lodEdgeIndexVBO);
+    glDeleteBuffers(1, &lodEdgeStateVBO);
+    glDeleteBuffers(1, &lodPositionVBO);
+    glDeleteBuffers(1, &lodColorVBO);
+    glDeleteTextures(1, &lodPositionTexture);
+    shaderManager.destroy();
 
     glfwTerminate();
     return 0;